@@ -10,6 +10,21 @@ OPT_LEVELS=${OPT_LEVELS:--O0 -O1 -O2 -O3 -Os}
 ASM_DIR="benchmark_asm"
 REPORT="benchmark_report.txt"
 
+# Usage:
+#   ./benchmark.sh            devirtualization report over examples/
+#   ./benchmark.sh --layout   vtable footprint and base-call time: extends vs extends_shared
+#   ./benchmark.sh --runtime  ns/call (and cycles, branch misses) per dispatch path
+#   ./benchmark.sh --size [FILE...]
+#                             code/rodata/relocations per trait and impl
+MODE=devirt
+case "${1:-}" in
+  --layout) MODE=layout ;;
+  --runtime) MODE=runtime ;;
+  --size) MODE=size; shift ;;
+  "") ;;
+  *) echo "usage: $0 [--layout | --runtime | --size [FILE...]]" >&2; exit 2 ;;
+esac
+
 # ── color handling ───────────────────────────────────────────────────────────
 
 setup_colors() {
@@ -25,6 +40,513 @@ setup_colors() {
 }
 setup_colors
 
+# ── layout mode ─────────────────────────────────────────────────────────────
+#
+# Builds one synthetic TU per layout: a base trait with LAYOUT_METHODS methods,
+# LAYOUT_TRAITS traits extending it, and one type implementing all of them.
+# Every vtable is kept alive through dyn(), then object sizes are compared.
+# The same TU built with -DLAYOUT_TIMING times call(Base.b0) on DynD0 objects
+# (a base-method call through the derived vtable) for LAYOUT_ITERS calls:
+# extends_shared pays one extra dependent load per call.
+
+LAYOUT_TRAITS=${LAYOUT_TRAITS:-8}
+LAYOUT_METHODS=${LAYOUT_METHODS:-12}
+LAYOUT_ITERS=${LAYOUT_ITERS:-20000000}
+
+gen_layout_tu() {
+  local ext="$1" i m
+  echo '#define _GNU_SOURCE'
+  echo '#include "trait.h"'
+  printf '#define BaseSignature(Self)'
+  for ((m = 0; m < LAYOUT_METHODS; m++)); do printf ' required(Self, int, b%d)' "$m"; done
+  printf '\n#define Dynamic\n#define Trait Base\n#include "trait.h"\n'
+  printf '#define For Default\n#define Impl Base\n#include "trait.h"\n'
+  for ((i = 0; i < LAYOUT_TRAITS; i++)); do
+    printf '#define D%dSignature(Self) %s(Base, Self) required(Self, int, d%d)\n' "$i" "$ext" "$i"
+    printf '#define Dynamic\n#define Trait D%d\n#include "trait.h"\n' "$i"
+    printf '#define For Default\n#define Impl D%d\n#include "trait.h"\n' "$i"
+  done
+  echo 'typedef struct { int x; } T;'
+  printf '#define For T\n#define Impl Base\n'
+  for ((m = 0; m < LAYOUT_METHODS; m++)); do printf 'int def(b%d) { return self->x + %d; }\n' "$m" "$m"; done
+  printf '#include "trait.h"\n'
+  for ((i = 0; i < LAYOUT_TRAITS; i++)); do
+    printf '#define For T\n#define Impl D%d\nint def(d%d) { return self->x; }\n#include "trait.h"\n' "$i" "$i"
+  done
+  echo 'const void *layout_keep[] = {'
+  for ((i = 0; i < LAYOUT_TRAITS; i++)); do printf '  &T_D%d_vtable,\n' "$i"; done
+  echo '};'
+  cat <<'C'
+#ifdef LAYOUT_TIMING
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define N 1024
+static T objs[N];
+static DynD0 views[N];
+static volatile long sink;
+
+__attribute__((noinline)) static long run_base(long n) {
+  long s = 0;
+  for (long i = 0; i < n; i++) s += call(Base.b0, &views[i & (N - 1)]);
+  return s;
+}
+
+int main(int argc, char **argv) {
+  long n = argc > 1 ? atol(argv[1]) : 20000000;
+  struct timespec t0, t1;
+  for (int i = 0; i < N; i++) {
+    objs[i].x = i;
+    views[i] = dyn(D0, &objs[i]);
+  }
+  sink = run_base(n / 8);
+  clock_gettime(CLOCK_MONOTONIC, &t0);
+  sink = run_base(n);
+  clock_gettime(CLOCK_MONOTONIC, &t1);
+  printf("%.3f\n", ((t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec)) / n);
+  return 0;
+}
+#endif
+C
+}
+
+# Sum of symbol sizes matching a pattern (nm -S prints hex sizes).
+sym_bytes() {
+  local total=0 size
+  while read -r size; do
+    total=$((total + 16#$size))
+  done < <(nm -S "$1" 2>/dev/null | awk -v pat="$2" 'NF == 4 && $4 ~ pat { print $2 }')
+  echo "$total"
+}
+
+# Size of a section by name (0 when absent).
+section_bytes() {
+  size -A "$1" 2>/dev/null | awk -v sec="$2" '$1 == sec { print $2; f = 1 } END { if (!f) print 0 }'
+}
+
+run_layout() {
+  local dir="$ASM_DIR/layout" ext obj
+  rm -rf "$dir"
+  mkdir -p "$dir"
+  echo "${BOLD}Vtable layout: extends vs extends_shared${RST}"
+  echo "  $LAYOUT_TRAITS traits extending one base of $LAYOUT_METHODS methods, one type implementing all"
+  echo ""
+  printf "${BOLD}%-16s| %-14s| %-14s| %-14s| %-12s| %-12s${RST}\n" \
+    "Layout" "vtable bytes" ".rodata" ".data.rel.ro" "D0 vtable" "base ns/call"
+  printf "%-16s| %-14s| %-14s| %-14s| %-12s| %-12s\n" \
+    "" "------------" "------------" "------------" "----------" "----------"
+  {
+    echo "=== Vtable layout benchmark ==="
+    echo "Compiler: $($CC --version 2>/dev/null | head -1)"
+    echo "Traits: $LAYOUT_TRAITS  Base methods: $LAYOUT_METHODS  Calls: $LAYOUT_ITERS"
+    echo ""
+  } > "$REPORT"
+  for ext in extends extends_shared; do
+    gen_layout_tu "$ext" > "$dir/$ext.c"
+    obj="$dir/$ext.o"
+    if ! $CC -O2 -fPIC -c -I. -o "$obj" "$dir/$ext.c" 2>"$dir/$ext.err"; then
+      echo "  ${FAIL}FAIL${RST}  $ext (compile error, see $dir/$ext.err)"
+      continue
+    fi
+    local vt ro relro d0 ns=-
+    vt=$(sym_bytes "$obj" '_vtable$')
+    ro=$(section_bytes "$obj" .rodata)
+    relro=$(section_bytes "$obj" .data.rel.ro)
+    d0=$(sym_bytes "$obj" '^T_D0_vtable$')
+    if $CC -O2 -DLAYOUT_TIMING -I. -o "$dir/$ext" "$dir/$ext.c" 2>>"$dir/$ext.err"; then
+      ns=$("$dir/$ext" "$LAYOUT_ITERS")
+    fi
+    printf "%-16s| %-14s| %-14s| %-14s| %-12s| %-12s\n" "$ext" "$vt" "$ro" "$relro" "$d0" "$ns"
+    echo "$ext: vtable_bytes=$vt rodata=$ro data_rel_ro=$relro d0_vtable=$d0 base_ns_per_call=$ns" >> "$REPORT"
+  done
+  echo ""
+  echo "  Sources/objects: ${BOLD}$dir/${RST}"
+  echo "  Report:          ${BOLD}$REPORT${RST}"
+}
+
+if [ "$MODE" = layout ]; then
+  run_layout
+  exit 0
+fi
+
+# ── runtime mode ────────────────────────────────────────────────────────────
+#
+# Builds one synthetic TU with RUNTIME_TYPES types implementing Shape and
+# Solid (extends Shape), then times the same method through each dispatch
+# path over a 1024-element array whose entries cycle through 1, 4 or 64
+# concrete types (mono-, 4-way and 64-way megamorphic call sites):
+#   direct  call() on a concrete pointer (static dispatch, monomorphic only)
+#   dyn     call() on DynShape
+#   dfl     call() on DynShape for a defaults() method (DFL wrapper)
+#   base    call(Shape.area) on DynSolid (extends-replayed base method)
+#   fnptr   hand-written { self, fn } pair, the baseline
+# Cycles and branch misses come from perf_event_open when the kernel allows
+# it; otherwise those fields are null and only clock_gettime ns are reported.
+
+RUNTIME_CCS=${RUNTIME_CCS:-$CC}
+RUNTIME_ITERS=${RUNTIME_ITERS:-4000000}
+RUNTIME_TYPES=64
+RUNTIME_REPORT="benchmark_runtime.json"
+
+gen_runtime_tu() {
+  local k
+  cat <<'C'
+#define _GNU_SOURCE
+#include "trait.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#define ShapeSignature(Self)                     \
+  required(immutable(Self), int, area)          \
+  defaults(immutable(Self), int, scaled)
+#define Dynamic
+#define Trait Shape
+#include "trait.h"
+
+#define For Default
+#define Impl Shape
+int constdef(scaled) { (void)self; return 2; }
+#include "trait.h"
+
+#define SolidSignature(Self)                     \
+  extends(Shape, Self)                          \
+  required(immutable(Self), int, volume)
+#define Dynamic
+#define Trait Solid
+#include "trait.h"
+
+#define For Default
+#define Impl Solid
+#include "trait.h"
+
+typedef struct { const void *self; int (*area)(const void *); } FnObj;
+C
+  for ((k = 0; k < RUNTIME_TYPES; k++)); do
+    cat <<C
+typedef struct { int v; } T$k;
+#define For T$k
+#define Impl Shape
+int constdef(area) { return self->v + $k; }
+#include "trait.h"
+#define For T$k
+#define Impl Solid
+int constdef(volume) { return self->v * $k; }
+#include "trait.h"
+static int fp_area_$k(const void *p) { return ((const T$k *)p)->v + $k; }
+static T$k obj_$k = { $k };
+C
+  done
+  echo 'static void make(int k, DynShape *s, DynSolid *d, FnObj *f) {'
+  echo '  switch (k) {'
+  for ((k = 0; k < RUNTIME_TYPES; k++)); do
+    echo "  case $k: *s = dyn(Shape, &obj_$k); *d = dyn(Solid, &obj_$k); *f = (FnObj){&obj_$k, fp_area_$k}; break;"
+  done
+  echo '  }'
+  echo '}'
+  cat <<'C'
+
+#define N 1024
+static T0 direct[N];
+static DynShape dshape[N];
+static DynSolid dsolid[N];
+static FnObj fobj[N];
+static volatile long sink;
+
+__attribute__((noinline)) static long run_direct(long n) {
+  long s = 0;
+  for (long i = 0; i < n; i++) s += call(Shape.area, &direct[i & (N - 1)]);
+  return s;
+}
+__attribute__((noinline)) static long run_dyn(long n) {
+  long s = 0;
+  for (long i = 0; i < n; i++) s += call(Shape.area, &dshape[i & (N - 1)]);
+  return s;
+}
+__attribute__((noinline)) static long run_dfl(long n) {
+  long s = 0;
+  for (long i = 0; i < n; i++) s += call(Shape.scaled, &dshape[i & (N - 1)]);
+  return s;
+}
+__attribute__((noinline)) static long run_base(long n) {
+  long s = 0;
+  for (long i = 0; i < n; i++) s += call(Shape.area, &dsolid[i & (N - 1)]);
+  return s;
+}
+__attribute__((noinline)) static long run_fnptr(long n) {
+  long s = 0;
+  for (long i = 0; i < n; i++) {
+    const FnObj *o = &fobj[i & (N - 1)];
+    s += o->area(o->self);
+  }
+  return s;
+}
+
+// Entries cycle through `sites` types in a fixed pseudo-random order.
+static void fill(int sites) {
+  unsigned x = 12345;
+  for (int i = 0; i < N; i++) {
+    x = x * 1103515245u + 12345u;
+    make(sites == 1 ? 0 : (int)((x >> 16) % (unsigned)sites), &dshape[i], &dsolid[i], &fobj[i]);
+    direct[i].v = i;
+  }
+}
+
+static int perf_fd[2] = {-1, -1};
+
+static void perf_open(void) {
+#ifdef __linux__
+  static const unsigned long long ev[2] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_BRANCH_MISSES};
+  for (int i = 0; i < 2; i++) {
+    struct perf_event_attr a;
+    memset(&a, 0, sizeof a);
+    a.size = sizeof a;
+    a.type = PERF_TYPE_HARDWARE;
+    a.config = ev[i];
+    a.disabled = 1;
+    a.exclude_kernel = 1;
+    a.exclude_hv = 1;
+    perf_fd[i] = (int)syscall(SYS_perf_event_open, &a, 0, -1, -1, 0);
+    if (perf_fd[i] < 0) {
+      if (i) close(perf_fd[0]);
+      perf_fd[0] = perf_fd[1] = -1;
+      return;
+    }
+  }
+#endif
+}
+
+static void perf_ctl(int on) {
+#ifdef __linux__
+  for (int i = 0; i < 2 && perf_fd[0] >= 0; i++) {
+    if (on) ioctl(perf_fd[i], PERF_EVENT_IOC_RESET, 0);
+    ioctl(perf_fd[i], on ? PERF_EVENT_IOC_ENABLE : PERF_EVENT_IOC_DISABLE, 0);
+  }
+#else
+  (void)on;
+#endif
+}
+
+static void measure(const char *path, int sites, long (*fn)(long), long n) {
+  struct timespec t0, t1;
+  long long hw[2] = {0, 0};
+  sink = fn(n / 8);
+  perf_ctl(1);
+  clock_gettime(CLOCK_MONOTONIC, &t0);
+  sink = fn(n);
+  clock_gettime(CLOCK_MONOTONIC, &t1);
+  perf_ctl(0);
+  double ns = (t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec);
+  printf("%s\t%d\t%.3f", path, sites, ns / n);
+  for (int i = 0; i < 2; i++) {
+    if (perf_fd[0] >= 0 && read(perf_fd[i], &hw[i], sizeof hw[i]) == sizeof hw[i])
+      printf("\t%.3f", (double)hw[i] / n);
+    else
+      printf("\tnull");
+  }
+  printf("\n");
+}
+
+int main(int argc, char **argv) {
+  long n = argc > 1 ? atol(argv[1]) : 4000000;
+  static const int sites[] = {1, 4, 64};
+  perf_open();
+  for (int s = 0; s < 3; s++) {
+    fill(sites[s]);
+    if (sites[s] == 1) measure("direct", 1, run_direct, n);
+    measure("dyn", sites[s], run_dyn, n);
+    measure("dfl", sites[s], run_dfl, n);
+    measure("base", sites[s], run_base, n);
+    measure("fnptr", sites[s], run_fnptr, n);
+  }
+  return 0;
+}
+C
+}
+
+json_str() { printf '"%s"' "$(printf '%s' "$1" | sed 's/\\/\\\\/g; s/"/\\"/g')"; }
+
+run_runtime() {
+  local dir="$ASM_DIR/runtime" cc opt bin first=1 path sites ns cyc miss
+  rm -rf "$dir"
+  mkdir -p "$dir"
+  gen_runtime_tu > "$dir/runtime.c"
+  echo "${BOLD}Runtime dispatch cost${RST}"
+  echo "  $RUNTIME_ITERS calls per case; call sites cycle through 1, 4 or 64 types"
+  echo ""
+  printf "${BOLD}%-10s| %-6s| %-7s| %-6s| %-10s| %-11s| %-11s${RST}\n" \
+    "Compiler" "Opt" "Path" "Sites" "ns/call" "cycles/call" "br-miss/call"
+  {
+    echo "{"
+    echo "  \"iterations\": $RUNTIME_ITERS,"
+    echo "  \"results\": ["
+  } > "$RUNTIME_REPORT"
+  for cc in $RUNTIME_CCS; do
+    if ! command -v "$cc" >/dev/null 2>&1; then
+      echo "  ${WARN}SKIP${RST}  $cc (not found)"
+      continue
+    fi
+    for opt in $OPT_LEVELS; do
+      bin="$dir/runtime_${cc##*/}_${opt#-}"
+      if ! "$cc" -std=gnu11 "$opt" -I. -o "$bin" "$dir/runtime.c" 2>"$bin.err"; then
+        echo "  ${FAIL}FAIL${RST}  $cc $opt (compile error, see $bin.err)"
+        continue
+      fi
+      while IFS=$'\t' read -r path sites ns cyc miss; do
+        printf "%-10s| %-6s| %-7s| %-6s| %-10s| %-11s| %-11s\n" \
+          "${cc##*/}" "$opt" "$path" "$sites" "$ns" "$cyc" "$miss"
+        [ "$first" = 1 ] || echo "," >> "$RUNTIME_REPORT"
+        first=0
+        printf '    {"cc": %s, "version": %s, "opt": %s, "path": %s, "sites": %s, "ns_per_call": %s, "cycles_per_call": %s, "branch_misses_per_call": %s}' \
+          "$(json_str "$cc")" "$(json_str "$("$cc" --version 2>/dev/null | head -1)")" \
+          "$(json_str "$opt")" "$(json_str "$path")" "$sites" "$ns" "$cyc" "$miss" >> "$RUNTIME_REPORT"
+      done < <("$bin" "$RUNTIME_ITERS")
+    done
+  done
+  {
+    echo ""
+    echo "  ]"
+    echo "}"
+  } >> "$RUNTIME_REPORT"
+  echo ""
+  echo "  Sources/binaries: ${BOLD}$dir/${RST}"
+  echo "  Report:           ${BOLD}$RUNTIME_REPORT${RST}"
+}
+
+if [ "$MODE" = runtime ]; then
+  run_runtime
+  exit 0
+fi
+
+# ── size mode ───────────────────────────────────────────────────────────────
+#
+# Compiles each example (or the FILEs given after --size) to an object with
+# -ffunction-sections -fdata-sections -DTRAIT_SYMMAP, so every symbol sits in
+# its own section, and attributes each symbol to a (trait, impl) row:
+#   methods   Type_Trait_method bodies and default wrappers, Default_Trait_*
+#   wrappers  SD/DynSD/TT/upcast wrappers (named through the symmap table)
+#             and Type_as_Trait helpers
+#   vtable    Type_Trait_vtable objects
+# Trait selector objects go to an "-" impl row, dynamic wrappers to "dyn",
+# everything else (main, user globals) to "(other)".  Relocations are counted
+# from each symbol's own .rela section.
+
+SIZE_OPT=${SIZE_OPT:--Os}
+SIZE_CFLAGS=${SIZE_CFLAGS:-}
+
+# TSV: trait impl text rodata relocs methods wrappers vtable
+size_attribute() {
+  local obj="$1"
+  awk -F'\t' '
+    FILENAME == ARGV[1] {                      # symmap: sym name kind
+      split($0, f, " "); n = split(f[2], p, ".")
+      if (f[3] == "upcast") { trait[f[1]] = p[3]; impl[f[1]] = "dyn" }
+      else if (f[3] == "dyn") { trait[f[1]] = p[2]; impl[f[1]] = "dyn" }
+      else { trait[f[1]] = p[2]; impl[f[1]] = p[1] }
+      traits[trait[f[1]]] = 1
+      if (f[3] == "static" || f[3] == "tt") {
+        pair[p[1] "_" p[2]] = p[1] SUBSEP p[2]
+        pair["Default_" p[2]] = "Default" SUBSEP p[2]
+      }
+      if (f[3] == "static") {
+        meth[p[1] "_" p[2] "_" p[3]] = p[1] SUBSEP p[2]
+        meth["Default_" p[2] "_" p[3]] = "Default" SUBSEP p[2]
+      }
+      next
+    }
+    FILENAME == ARGV[2] { rel[$1] = $2; next } # relocs: sym count
+    {                                          # nm -S -t d: addr size type sym
+      split($0, f, " ")
+      sym = f[4]; size = f[2] + 0; t = tolower(f[3])
+      if (sym ~ /_symmap$/ || t == "b") next
+      text = (t == "t") ? size : 0
+      ro = (t == "t") ? 0 : size
+      col = ""
+      if (sym in trait) { k = impl[sym] SUBSEP trait[sym]; col = "w" }
+      else if (sym in meth) { k = meth[sym]; col = "m" }
+      else if (sym ~ /_vtable$/ && (substr(sym, 1, length(sym) - 7) in pair)) {
+        k = pair[substr(sym, 1, length(sym) - 7)]; col = "v"
+      } else if (match(sym, /_as_[A-Za-z0-9_]+$/) && (substr(sym, RSTART + 4) in traits)) {
+        k = substr(sym, 1, RSTART - 1) SUBSEP substr(sym, RSTART + 4); col = "w"
+      } else if (sym in traits) k = "-" SUBSEP sym
+      else k = "-" SUBSEP "(other)"
+      rows[k] = 1
+      T[k] += text; R[k] += ro; L[k] += rel[sym]
+      if (col == "m") M[k] += size
+      if (col == "w") W[k] += size
+      if (col == "v") V[k] += size
+    }
+    END {
+      for (k in rows) {
+        split(k, q, SUBSEP)
+        printf "%s\t%s\t%d\t%d\t%d\t%d\t%d\t%d\n", q[2], q[1], T[k], R[k], L[k], M[k], W[k], V[k]
+      }
+    }
+  ' <(./symmap.sh --list "$obj") \
+    <(readelf -rW "$obj" | sed -nE "s/^Relocation section '\.rela\.(text|rodata|data\.rel\.ro\.local|data\.rel\.ro|data\.rel\.local|data\.rel|data)(\.startup|\.unlikely|\.hot)?\.([^']+)' .* contains ([0-9]+) entr.*/\3\t\4/p") \
+    <(nm -S -t d --size-sort "$obj") |
+    sort -t$'\t' -k1,1 -k2,2
+}
+
+run_size() {
+  local dir="$ASM_DIR/size" src name obj srcs=("$@") sum
+  if [ ${#srcs[@]} -eq 0 ]; then
+    for src in examples/e*.c examples/demo.c; do
+      [ -f "$src" ] && srcs+=("$src")
+    done
+  fi
+  rm -rf "$dir"
+  mkdir -p "$dir"
+  echo "${BOLD}Code size per trait and impl ($CC $SIZE_OPT)${RST}"
+  echo "  methods = impl bodies and default wrappers, wrappers = SD/DynSD/TT/upcast"
+  {
+    echo "=== Code size benchmark ==="
+    echo "Compiler: $($CC --version 2>/dev/null | head -1)"
+    echo "Flags: $SIZE_OPT $SIZE_CFLAGS"
+    echo "# file trait impl text rodata relocs methods wrappers vtable"
+  } > "$REPORT"
+  for src in "${srcs[@]}"; do
+    name="${src##*/}"
+    name="${name%.c}"
+    obj="$dir/$name.o"
+    echo ""
+    # shellcheck disable=SC2086
+    if ! $CC "$SIZE_OPT" $SIZE_CFLAGS -DTRAIT_SYMMAP -ffunction-sections -fdata-sections \
+        -c -I. -o "$obj" "$src" 2>"$dir/$name.err"; then
+      echo "  ${FAIL}FAIL${RST}  $name (compile error, see $dir/$name.err)"
+      continue
+    fi
+    echo "${BOLD}$name${RST}"
+    printf "${BOLD}  %-14s| %-12s| %-7s| %-7s| %-7s| %-8s| %-9s| %-7s${RST}\n" \
+      "Trait" "Impl" "text" "rodata" "relocs" "methods" "wrappers" "vtable"
+    size_attribute "$obj" > "$dir/$name.tsv"
+    while IFS=$'\t' read -r -a row; do
+      printf "  %-14s| %-12s| %-7s| %-7s| %-7s| %-8s| %-9s| %-7s\n" "${row[@]}"
+      printf '%s\t' "$name" >> "$REPORT"
+      (IFS=$'\t'; echo "${row[*]}") >> "$REPORT"
+    done < "$dir/$name.tsv"
+    sum=$(awk -F'\t' '$1 != "(other)" { t += $3; r += $4; l += $5 } END { printf "%d\t%d\t%d", t, r, l }' "$dir/$name.tsv")
+    IFS=$'\t' read -r t r l <<< "$sum"
+    printf "  ${BOLD}%-14s| %-12s| %-7s| %-7s| %-7s${RST}\n" "trait total" "" "$t" "$r" "$l"
+  done
+  echo ""
+  echo "  Objects: ${BOLD}$dir/${RST}"
+  echo "  Report:  ${BOLD}$REPORT${RST}"
+}
+
+if [ "$MODE" = size ]; then
+  run_size "$@"
+  exit 0
+fi
+
 # ── gather examples ─────────────────────────────────────────────────────────
 
 examples=()
@@ -52,13 +574,27 @@ count_fully_indirect() { _count '\bcallq?\s+\*%[a-z]' "$1"; }
 # callq *symbol(%rip) or *symbol+offset(%rip) — vtable base known at link time
 count_partial() { _count '\bcallq?\s+\*[A-Za-z_]' "$1"; }
 
+# Names of trait functions in one TU, from its -DTRAIT_SYMMAP table: the
+# generated wrappers themselves, and for each static slot the impl function
+# (Type_Trait_method) and the trait's default body (Default_Trait_method).
+trait_function_names() {
+  ./symmap.sh --list "$1" | awk '{
+    print $1
+    if ($3 == "static") {
+      n = split($2, p, ".")
+      print p[1] "_" p[2] "_" p[3]
+      print "Default_" p[2] "_" p[3]
+    }
+  }' | sort -u
+}
+
 # callq SymbolName — direct call to a named function (fully devirtualized)
 find_trait_direct_calls() {
   grep -oE '\bcallq?\s+[A-Za-z_][A-Za-z0-9_]*' "$1" 2>/dev/null \
     | sed 's/^callq\?[[:space:]]*//' \
-    | grep -iE '(Animal|Show|Pet|Reader|Logged|Container|Default|Dog_|IntBox_|StrBox_)' \
-    | grep -vE '@PLT|puts|printf|__stack|__libc' \
-    | sort -u || true
+    | grep -Fxf <(trait_function_names "$1") \
+    | sort -u \
+    | ./symmap.sh "$1" || true
 }
 
 count_vtable_refs() { _count '_vtable' "$1"; }
@@ -99,7 +635,7 @@ for opt in $OPT_LEVELS; do
     name="${src##*/}"
     name="${name%.c}"
     outfile="$ASM_DIR/${name}_${opt}.s"
-    if $CC "$opt" -S -I. -o "$outfile" "$src" 2>"$ASM_DIR/${name}_${opt}.err"; then
+    if $CC "$opt" -DTRAIT_SYMMAP -S -I. -o "$outfile" "$src" 2>"$ASM_DIR/${name}_${opt}.err"; then
       compile_ok["${name}_${opt}"]=1
     else
       compile_ok["${name}_${opt}"]=0
@@ -200,7 +736,7 @@ for src in "${examples[@]}"; do
     if [ "$opt" = "-O2" ]; then
       echo ""
       echo "  --- $opt main() assembly ---"
-      get_main_range "$outfile" | sed 's/^/  /'
+      get_main_range "$outfile" | ./symmap.sh "$outfile" | sed 's/^/  /'
       echo ""
     fi
 
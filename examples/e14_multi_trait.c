@@ -0,0 +1,168 @@
+// clang-format off
+#include "../trait.h"
+#include <stdio.h>
+
+// Multi-trait objects: one self pointer, one vtable pointer per trait.
+//   #define Multi Animal, Show
+//   #include "trait.h"
+// declares Dyn2(Animal, Show):
+//   typedef struct {
+//     void *self;
+//     const Animal_vtable *Animal;
+//     const Show_vtable *Show;
+//   } Dyn2_Animal_Show;
+// and registers every member method for it, so call() routes each selector
+// through the matching vtable field:
+//   Dyn2(Animal, Show) m = dyn2(Animal, Show, &dog);
+//   call(Animal.get_snacks, &m);   // m.Animal->get_snacks(m.self)
+//   call(Show.show, &m);           // m.Show->show(m.self)
+
+// ---- trait: Animal -----------------------------------------------------------
+#define AnimalSignature(Self)                    \
+  required(Self, int,  get_snacks)            \
+  defaults(Self, void, feed, int)
+#define Dynamic
+#define Trait Animal
+#include "../trait.h"
+
+#define For Default
+#define Impl Animal
+  void def(feed, int amount) {
+    (void)self;
+    printf("(default) fed %d.\n", amount);
+  }
+#include "../trait.h"
+
+
+// ---- trait: Show -------------------------------------------------------------
+#define ShowSignature(Self)                      \
+  required(immutable(Self), int, show)         \
+  defaults(immutable(Self), int, width)
+#define Dynamic
+#define Trait Show
+#include "../trait.h"
+
+#define For Default
+#define Impl Show
+  int constdef(width) {
+    (void)self;
+    return 8;
+  }
+#include "../trait.h"
+
+
+// ---- trait: Named ------------------------------------------------------------
+#define NamedSignature(Self)                     \
+  required(immutable(Self), const char *, name)
+#define Dynamic
+#define Trait Named
+#include "../trait.h"
+
+#define For Default
+#define Impl Named
+#include "../trait.h"
+
+
+// ---- multi-trait objects -----------------------------------------------------
+#define Multi Animal, Show
+#include "../trait.h"
+
+#define Multi Animal, Show, Named
+#include "../trait.h"
+
+
+// ---- type definitions --------------------------------------------------------
+typedef struct { int snacks; const char *name; } Dog;
+typedef struct { int seeds; } Parrot;
+
+
+// ---- impl: Animal, Show, Named for Dog ---------------------------------------
+#define For Dog
+#define Impl Animal
+  int def(get_snacks) { return self->snacks; }
+  void def(feed, int amount) { self->snacks += amount; }
+#define Override_Dog_Animal_feed 1
+#include "../trait.h"
+
+#define For Dog
+#define Impl Show
+  int constdef(show) { return printf("Dog(%s, %d snacks)\n", self->name, self->snacks); }
+#include "../trait.h"
+
+#define For Dog
+#define Impl Named
+  const char *constdef(name) { return self->name; }
+#include "../trait.h"
+
+
+// ---- impl: Animal, Show for Parrot (defaults only where allowed) -------------
+#define For Parrot
+#define Impl Animal
+  int def(get_snacks) { return self->seeds; }
+#include "../trait.h"
+
+#define For Parrot
+#define Impl Show
+  int constdef(show) { return printf("Parrot(%d seeds)\n", self->seeds); }
+  int constdef(width) { (void)self; return 3; }
+#define Override_Parrot_Show_width 1
+#include "../trait.h"
+
+
+// ---- main --------------------------------------------------------------------
+static int tests = 0, passed = 0;
+#define TEST(cond, msg) do { tests++; if (cond) { passed++; } \
+  else { printf("  FAIL: %s\n", msg); } } while(0)
+
+static int total_snacks(Dyn2(Animal, Show) *xs, int n) {
+  int sum = 0;
+  for (int i = 0; i < n; i++) {
+    call(Show.show, &xs[i]);
+    sum += call(Animal.get_snacks, &xs[i]);
+  }
+  return sum;
+}
+
+int main(void) {
+  Dog d = { .snacks = 2, .name = "Rex" };
+  Parrot p = { .seeds = 5 };
+
+  printf("=== Dyn2(Animal, Show) ===\n");
+  Dyn2(Animal, Show) md = dyn2(Animal, Show, &d);
+  TEST(md.self == &d, "dyn2: self points at the object");
+  TEST(md.Animal == dyn(Animal, &d).vt, "dyn2: Animal vtable from registry");
+  TEST(md.Show == dyn(Show, &d).vt, "dyn2: Show vtable from registry");
+  TEST(call(Animal.get_snacks, &md) == 2, "call(Animal.get_snacks) == 2");
+  call(Animal.feed, &md, 3);
+  TEST(call(Animal.get_snacks, &md) == 5, "call(Animal.feed) mutates through self");
+  TEST(call(Show.show, &md) > 0, "call(Show.show) via Show field");
+  TEST(call(Show.width, &md) == 8, "call(Show.width) default");
+
+  // One self pointer shared by both vtables.
+  TEST(sizeof(Dyn2(Animal, Show)) == 3 * sizeof(void *), "sizeof Dyn2 == 3 pointers");
+  TEST(sizeof(Dyn2(Animal, Show)) < sizeof(DynAnimal) + sizeof(DynShow),
+       "Dyn2 smaller than two separate trait objects");
+
+  printf("\n=== heterogeneous array ===\n");
+  Dyn2(Animal, Show) xs[] = { md, dyn2(Animal, Show, &p) };
+  TEST(total_snacks(xs, 2) == 10, "array of Dyn2: 5 + 5 snacks");
+  TEST(call(Show.width, &xs[1]) == 3, "Parrot overrides Show.width");
+  call(Animal.feed, &xs[1], 1);   // default feed: no state change
+  TEST(p.seeds == 5, "Parrot uses default Animal.feed");
+
+  printf("\n=== Dyn3(Animal, Show, Named) ===\n");
+  DynMulti(Animal, Show, Named) m3 = dyn3(Animal, Show, Named, &d);
+  TEST(sizeof(m3) == 4 * sizeof(void *), "sizeof Dyn3 == 4 pointers");
+  TEST(call(Animal.get_snacks, &m3) == 5, "Dyn3: Animal.get_snacks");
+  TEST(call(Show.width, &m3) == 8, "Dyn3: Show.width");
+  const char *nm = call(Named.name, &m3);
+  TEST(nm[0] == 'R', "Dyn3: Named.name");
+  Dog pack[2] = { { .snacks = 7, .name = "A" }, { .snacks = 9, .name = "B" } };
+  Dog *next = pack;
+  DynMulti(Animal, Show, Named) m4 = dyn3(Animal, Show, Named, next++);
+  TEST(next == pack + 1 && m4.self == pack && call(Animal.get_snacks, &m4) == 7,
+       "dyn3 evaluates ptr once");
+
+  printf("\n=== Results: %d/%d tests passed ===\n", passed, tests);
+  return tests == passed ? 0 : 1;
+}
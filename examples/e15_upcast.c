@@ -0,0 +1,199 @@
+// clang-format off
+#include "../trait.h"
+#include <stdio.h>
+
+// upcast(Base, &dyn_derived) re-views a trait object as any supertrait, at any
+// depth.  The base vtable is embedded by value in the derived one, so the
+// result shares self and points vt into the derived vtable:
+//   DynGuideDog dg = dyn(GuideDog, &d);
+//   DynAnimal da = upcast(Animal, &dg);   // da.vt == &dg.vt->Pet.Animal
+// No concrete pointer or dyn() lookup is needed — only the trait object.
+
+// ---- trait: Animal -----------------------------------------------------------
+#define AnimalSignature(Self)                    \
+  required(Self, int,  get_snacks)            \
+  defaults(Self, void, feed, int)
+#define Dynamic
+#define Trait Animal
+#include "../trait.h"
+
+#define For Default
+#define Impl Animal
+  void def(feed, int amount) {
+    (void)self;
+    printf("(default) fed %d.\n", amount);
+  }
+#include "../trait.h"
+
+
+// ---- trait: Pet (extends Animal) ---------------------------------------------
+#define PetSignature(Self)                       \
+  extends(Animal, Self)                         \
+  required(immutable(Self), const char *, name)
+#define Dynamic
+#define Trait Pet
+#include "../trait.h"
+
+#define For Default
+#define Impl Pet
+#include "../trait.h"
+
+
+// ---- trait: GuideDog (extends Pet, two levels above Animal) ------------------
+#define GuideDogSignature(Self)                  \
+  extends(Pet, Self)                            \
+  required(Self, int, guide)
+#define Dynamic
+#define Trait GuideDog
+#include "../trait.h"
+
+#define For Default
+#define Impl GuideDog
+#include "../trait.h"
+
+
+// ---- diamond: Badge extends Greeter and Labeled, both extend Named -----------
+#define NamedSignature(Self)                     \
+  required(immutable(Self), int, id)
+#define Dynamic
+#define Trait Named
+#include "../trait.h"
+
+#define For Default
+#define Impl Named
+#include "../trait.h"
+
+#define GreeterSignature(Self)                   \
+  extends(Named, Self)                          \
+  required(immutable(Self), int, greet)
+#define Dynamic
+#define Trait Greeter
+#include "../trait.h"
+
+#define For Default
+#define Impl Greeter
+#include "../trait.h"
+
+#define LabeledSignature(Self)                   \
+  extends(Named, Self)                          \
+  required(immutable(Self), int, label)
+#define Dynamic
+#define Trait Labeled
+#include "../trait.h"
+
+#define For Default
+#define Impl Labeled
+#include "../trait.h"
+
+#define BadgeSignature(Self)                     \
+  extends(Greeter, Self)                        \
+  extends(Labeled, Self)                        \
+  required(immutable(Self), int, color)
+#define Dynamic
+#define Trait Badge
+#include "../trait.h"
+
+#define For Default
+#define Impl Badge
+#include "../trait.h"
+
+
+// ---- type definitions --------------------------------------------------------
+typedef struct { int snacks; const char *name; int routes; } Dog;
+typedef struct { int id; } Card;
+
+
+// ---- impls for Dog -----------------------------------------------------------
+#define For Dog
+#define Impl Animal
+  int def(get_snacks) { return self->snacks; }
+  void def(feed, int amount) { self->snacks += amount; }
+#define Override_Dog_Animal_feed 1
+#include "../trait.h"
+
+#define For Dog
+#define Impl Pet
+  const char *constdef(name) { return self->name; }
+#include "../trait.h"
+
+#define For Dog
+#define Impl GuideDog
+  int def(guide) { return ++self->routes; }
+#include "../trait.h"
+
+
+// ---- impls for Card ----------------------------------------------------------
+#define For Card
+#define Impl Named
+  int constdef(id) { return self->id; }
+#include "../trait.h"
+
+#define For Card
+#define Impl Greeter
+  int constdef(greet) { return self->id + 100; }
+#include "../trait.h"
+
+#define For Card
+#define Impl Labeled
+  int constdef(label) { return self->id + 200; }
+#include "../trait.h"
+
+#define For Card
+#define Impl Badge
+  int constdef(color) { return self->id + 300; }
+#include "../trait.h"
+
+
+// ---- main --------------------------------------------------------------------
+static int tests = 0, passed = 0;
+#define TEST(cond, msg) do { tests++; if (cond) { passed++; } \
+  else { printf("  FAIL: %s\n", msg); } } while(0)
+
+// Only needs an Animal — callers holding any sub-trait object upcast first.
+static int feed_and_count(DynAnimal a) {
+  call(Animal.feed, &a, 1);
+  return call(Animal.get_snacks, &a);
+}
+
+int main(void) {
+  Dog d = { .snacks = 2, .name = "Rex", .routes = 0 };
+  Card c = { .id = 7 };
+
+  printf("=== one hop ===\n");
+  DynPet dp = dyn(Pet, &d);
+  DynAnimal a1 = upcast(Animal, &dp);
+  TEST(a1.self == dp.self, "upcast keeps self");
+  TEST(a1.vt == &dp.vt->Animal, "vt points at the embedded Animal vtable");
+  TEST(call(Animal.get_snacks, &a1) == 2, "call through upcast object");
+
+  printf("\n=== two hops ===\n");
+  DynGuideDog dg = dyn(GuideDog, &d);
+  DynPet p2 = upcast(Pet, &dg);
+  DynAnimal a2 = upcast(Animal, &dg);
+  TEST(p2.vt == &dg.vt->Pet, "GuideDog -> Pet");
+  TEST(a2.vt == &dg.vt->Pet.Animal, "GuideDog -> Animal (transitive)");
+  // The embedded copy holds the same entries as Dog's own Animal vtable.
+  TEST(a2.vt->get_snacks == dyn(Animal, &d).vt->get_snacks, "same entries as dyn(Animal, &d)");
+  TEST(feed_and_count(upcast(Animal, &dg)) == 3, "pass upcast object by value");
+  TEST(d.snacks == 3, "feed went through to Dog");
+  const char *nm = call(Pet.name, &p2);
+  TEST(nm[0] == 'R', "Pet.name through upcast object");
+  TEST(call(GuideDog.guide, &dg) == 1, "derived object still usable");
+
+  // Upcast of an upcast lands on the same sub-vtable.
+  DynAnimal a3 = upcast(Animal, &p2);
+  TEST(a3.vt == a2.vt, "chained upcast == direct upcast");
+
+  printf("\n=== diamond ===\n");
+  DynBadge db = dyn(Badge, &c);
+  DynGreeter g = upcast(Greeter, &db);
+  DynLabeled l = upcast(Labeled, &db);
+  DynNamed n = upcast(Named, &db);
+  TEST(call(Greeter.greet, &g) == 107, "Badge -> Greeter");
+  TEST(call(Labeled.label, &l) == 207, "Badge -> Labeled");
+  TEST(n.vt == &db.vt->Greeter.Named, "diamond base resolves to first path");
+  TEST(call(Named.id, &n) == 7, "Badge -> Named");
+
+  printf("\n=== Results: %d/%d tests passed ===\n", passed, tests);
+  return tests == passed ? 0 : 1;
+}
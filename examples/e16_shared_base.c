@@ -0,0 +1,146 @@
+// clang-format off
+#include "../trait.h"
+#include <stdio.h>
+
+// extends_shared(Base, Self) stores a pointer to the implementing type's one
+// Base vtable instead of embedding a copy:
+//   typedef struct { const Sensor_vtable *Sensor; int (*calibrate)(void *); } Probe_vtable;
+// Every trait sharing the base points at the same Thermo_Sensor_vtable, so a
+// type implementing many of them keeps a single copy of the base table.
+// call() and upcast() follow the pointer transparently.
+
+// ---- trait: Sensor (the wide base) -------------------------------------------
+#define SensorSignature(Self)                    \
+  required(Self, int, read)                     \
+  required(Self, int, range)                    \
+  defaults(Self, int, scale)
+#define Dynamic
+#define Trait Sensor
+#include "../trait.h"
+
+#define For Default
+#define Impl Sensor
+  int def(scale) { (void)self; return 1; }
+#include "../trait.h"
+
+
+// ---- trait: Named (embedded by value, for mixing) ----------------------------
+#define NamedSignature(Self)                     \
+  required(immutable(Self), const char *, name)
+#define Dynamic
+#define Trait Named
+#include "../trait.h"
+
+#define For Default
+#define Impl Named
+#include "../trait.h"
+
+
+// ---- traits sharing Sensor ---------------------------------------------------
+#define ProbeSignature(Self)                     \
+  extends_shared(Sensor, Self)                  \
+  required(Self, int, calibrate)
+#define Dynamic
+#define Trait Probe
+#include "../trait.h"
+
+#define For Default
+#define Impl Probe
+#include "../trait.h"
+
+#define LoggerSignature(Self)                    \
+  extends_shared(Sensor, Self)                  \
+  extends(Named, Self)                          \
+  required(Self, int, log)
+#define Dynamic
+#define Trait Logger
+#include "../trait.h"
+
+#define For Default
+#define Impl Logger
+#include "../trait.h"
+
+
+// ---- trait: SmartProbe (extends Probe by value → Sensor two levels up) -------
+#define SmartProbeSignature(Self)                \
+  extends(Probe, Self)                          \
+  required(Self, int, learn)
+#define Dynamic
+#define Trait SmartProbe
+#include "../trait.h"
+
+#define For Default
+#define Impl SmartProbe
+#include "../trait.h"
+
+
+// ---- type + impls ------------------------------------------------------------
+typedef struct { int value; int logs; } Thermo;
+
+#define For Thermo
+#define Impl Sensor
+  int def(read) { return self->value; }
+  int def(range) { (void)self; return 100; }
+#include "../trait.h"
+
+#define For Thermo
+#define Impl Named
+  const char *constdef(name) { (void)self; return "thermo"; }
+#include "../trait.h"
+
+#define For Thermo
+#define Impl Probe
+  int def(calibrate) { self->value = 0; return 1; }
+#include "../trait.h"
+
+#define For Thermo
+#define Impl Logger
+  int def(log) { return ++self->logs; }
+#include "../trait.h"
+
+#define For Thermo
+#define Impl SmartProbe
+  int def(learn) { return self->value + 1; }
+#include "../trait.h"
+
+
+// ---- main --------------------------------------------------------------------
+static int tests = 0, passed = 0;
+#define TEST(cond, msg) do { tests++; if (cond) { passed++; } \
+  else { printf("  FAIL: %s\n", msg); } } while(0)
+
+int main(void) {
+  Thermo t = { .value = 21, .logs = 0 };
+
+  printf("=== layout ===\n");
+  TEST(sizeof(Probe_vtable) == 2 * sizeof(void *), "Probe_vtable: base pointer + calibrate");
+  TEST(sizeof(Logger_vtable) == sizeof(void *) + sizeof(Named_vtable) + sizeof(void *),
+       "Logger_vtable: shared Sensor, embedded Named, log");
+
+  DynProbe dp = dyn(Probe, &t);
+  DynLogger dl = dyn(Logger, &t);
+  TEST(dp.vt->Sensor == &Thermo_Sensor_vtable, "Probe points at the one Sensor vtable");
+  TEST(dl.vt->Sensor == dp.vt->Sensor, "Logger shares the same Sensor vtable");
+
+  printf("\n=== dispatch through the shared base ===\n");
+  TEST(call(Sensor.read, &dp) == 21, "call(Sensor.read) via Probe");
+  TEST(call(Sensor.range, &dl) == 100, "call(Sensor.range) via Logger");
+  TEST(call(Sensor.scale, &dl) == 1, "default Sensor.scale via Logger");
+  TEST(dp.vt->Sensor->read(dp.self) == 21, "direct access: vt->Sensor->read");
+  const char *nm = call(Named.name, &dl);
+  TEST(nm[0] == 't', "embedded base still works alongside");
+  TEST(call(Logger.log, &dl) == 1, "own method");
+  TEST(call(Probe.calibrate, &dp) == 1 && t.value == 0, "Probe.calibrate");
+
+  printf("\n=== upcast ===\n");
+  DynSensor s1 = upcast(Sensor, &dp);
+  TEST(s1.vt == dyn(Sensor, &t).vt, "upcast lands on the shared vtable");
+  DynSmartProbe sp = dyn(SmartProbe, &t);
+  DynSensor s2 = upcast(Sensor, &sp);
+  TEST(s2.vt == s1.vt, "two levels: SmartProbe -> Probe -> *Sensor");
+  t.value = 5;
+  TEST(call(Sensor.read, &s2) == 5, "call through upcast object");
+
+  printf("\n=== Results: %d/%d tests passed ===\n", passed, tests);
+  return tests == passed ? 0 : 1;
+}
@@ -0,0 +1,123 @@
+// clang-format off
+#include "../trait.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// hot(Self) / cold(Self) reorder vtable fields without touching call sites:
+//   hot entries first, then unannotated ones in signature order, then cold.
+// A trait with any hot entry gets its For##_Trait##_vtable objects aligned to
+// TRAIT_CACHE_LINE (64) bytes, so the hot block sits on one cache line.
+//   extends(Named, cold(Self))
+//   required(cold(Self), void, resize, double)
+//   defaults(immutable(Self), int, sides)
+//   required(hot(immutable(Self)), double, area)
+//   required(immutable(hot(Self)), double, perimeter)
+//   → { area; perimeter; sides; Named_vtable Named; resize; }
+
+// ---- trait: Named ------------------------------------------------------------
+#define NamedSignature(Self)                     \
+  required(immutable(Self), const char *, name)
+#define Dynamic
+#define Trait Named
+#include "../trait.h"
+
+#define For Default
+#define Impl Named
+#include "../trait.h"
+
+
+// ---- trait: Shape (hot area/perimeter, cold resize and Named) ----------------
+#define ShapeSignature(Self)                         \
+  extends(Named, cold(Self))                        \
+  required(cold(Self), void, resize, double)        \
+  defaults(immutable(Self), int, sides)             \
+  required(hot(immutable(Self)), double, area)      \
+  required(immutable(hot(Self)), double, perimeter)
+#define Dynamic
+#define Trait Shape
+#include "../trait.h"
+
+#define For Default
+#define Impl Shape
+  int constdef(sides) { (void)self; return 0; }
+#include "../trait.h"
+
+
+// ---- trait: Plain (no annotations: signature order, natural alignment) -------
+#define PlainSignature(Self)                     \
+  required(Self, int, a)                        \
+  required(Self, int, b)
+#define Dynamic
+#define Trait Plain
+#include "../trait.h"
+
+#define For Default
+#define Impl Plain
+#include "../trait.h"
+
+
+// ---- type + impls ------------------------------------------------------------
+typedef struct { double w, h; } Rect;
+
+#define For Rect
+#define Impl Named
+  const char *constdef(name) { (void)self; return "rect"; }
+#include "../trait.h"
+
+#define For Rect
+#define Impl Shape
+  void def(resize, double k) { self->w *= k; self->h *= k; }
+  double constdef(area) { return self->w * self->h; }
+  double constdef(perimeter) { return 2 * (self->w + self->h); }
+  int constdef(sides) { (void)self; return 4; }
+#define Override_Rect_Shape_sides 1
+#include "../trait.h"
+
+#define For Rect
+#define Impl Plain
+  int def(a) { return (int)self->w; }
+  int def(b) { return (int)self->h; }
+#include "../trait.h"
+
+
+// ---- main --------------------------------------------------------------------
+static int tests = 0, passed = 0;
+#define TEST(cond, msg) do { tests++; if (cond) { passed++; } \
+  else { printf("  FAIL: %s\n", msg); } } while(0)
+
+int main(void) {
+  Rect r = { 2, 3 };
+
+  printf("=== layout ===\n");
+  TEST(offsetof(Shape_vtable, area) == 0, "hot area first");
+  TEST(offsetof(Shape_vtable, perimeter) == sizeof(void *), "hot perimeter second");
+  TEST(offsetof(Shape_vtable, sides) == 2 * sizeof(void *), "unannotated in the middle");
+  TEST(offsetof(Shape_vtable, Named) == 3 * sizeof(void *), "cold embedded base after");
+  TEST(offsetof(Shape_vtable, resize) == 3 * sizeof(void *) + sizeof(Named_vtable),
+       "cold entries keep signature order");
+  TEST(offsetof(Plain_vtable, a) == 0 && offsetof(Plain_vtable, b) == sizeof(void *),
+       "no annotations: signature order");
+
+  printf("\n=== alignment ===\n");
+  TEST((uintptr_t)&Rect_Shape_vtable % TRAIT_CACHE_LINE == 0, "hot vtable on a cache line");
+  TEST(sizeof(Shape_vtable) == 5 * sizeof(void *), "type itself is not padded");
+
+  printf("\n=== dispatch by name is unaffected ===\n");
+  DynShape s = dyn(Shape, &r);
+  TEST(call(Shape.area, &s) == 6.0, "call(Shape.area)");
+  TEST(call(Shape.perimeter, &s) == 10.0, "call(Shape.perimeter)");
+  TEST(call(Shape.sides, &s) == 4, "call(Shape.sides)");
+  call(Shape.resize, &s, 2.0);
+  TEST(call(Shape.area, &s) == 24.0, "cold resize mutates");
+  const char *nm = call(Named.name, &s);
+  TEST(nm[0] == 'r', "cold embedded base still dispatches");
+  DynNamed n = upcast(Named, &s);
+  TEST(n.vt == &s.vt->Named, "upcast to cold base");
+  TEST(call(Shape.area, &r) == 24.0, "static dispatch");
+  DynPlain p = dyn(Plain, &r);
+  TEST(call(Plain.a, &p) == 4 && call(Plain.b, &p) == 6, "Plain dispatch");
+
+  printf("\n=== Results: %d/%d tests passed ===\n", passed, tests);
+  return tests == passed ? 0 : 1;
+}
@@ -0,0 +1,116 @@
+// clang-format off
+#define TRAIT_PROFILE
+#include "../trait.h"
+#include <stdio.h>
+#include <string.h>
+
+// -DTRAIT_PROFILE (here: #define before the first include) makes every call()
+// wrapper count its invocations.  trait_profile_dump(stdout) prints:
+//   static:
+//             3  Dog.Animal.get_snacks
+//   dynamic:
+//             2  DynAnimal.Animal.get_snacks
+// Static slots are keyed Type.Trait.method, dynamic ones by the trait object
+// type; a base method called through a derived object shows its vtable path.
+
+// ---- trait: Animal -----------------------------------------------------------
+#define AnimalSignature(Self)                    \
+  required(Self, int,  get_snacks)            \
+  defaults(Self, void, feed, int)
+#define Dynamic
+#define Trait Animal
+#include "../trait.h"
+
+#define For Default
+#define Impl Animal
+  void def(feed, int amount) { (void)self; (void)amount; }
+#include "../trait.h"
+
+
+// ---- trait: Pet (extends Animal) ---------------------------------------------
+#define PetSignature(Self)                       \
+  extends(Animal, Self)                         \
+  required(immutable(Self), const char *, name)
+#define Dynamic
+#define Trait Pet
+#include "../trait.h"
+
+#define For Default
+#define Impl Pet
+#include "../trait.h"
+
+
+// ---- type + impls ------------------------------------------------------------
+typedef struct { int snacks; } Dog;
+typedef struct { int seeds; } Parrot;
+
+#define For Dog
+#define Impl Animal
+  int def(get_snacks) { return self->snacks; }
+#include "../trait.h"
+
+#define For Dog
+#define Impl Pet
+  const char *constdef(name) { (void)self; return "Rex"; }
+#include "../trait.h"
+
+#define For Parrot
+#define Impl Animal
+  int def(get_snacks) { return self->seeds; }
+#include "../trait.h"
+
+
+// ---- main --------------------------------------------------------------------
+static int tests = 0, passed = 0;
+#define TEST(cond, msg) do { tests++; if (cond) { passed++; } \
+  else { printf("  FAIL: %s\n", msg); } } while(0)
+
+static char report[4096];
+
+static const char *dump(void) {
+  FILE *f = tmpfile();
+  if (!f) return "";
+  trait_profile_dump(f);
+  rewind(f);
+  size_t n = fread(report, 1, sizeof report - 1, f);
+  report[n] = '\0';
+  fclose(f);
+  return report;
+}
+
+int main(void) {
+  Dog d = { .snacks = 2 };
+  Parrot p = { .seeds = 4 };
+
+  for (int i = 0; i < 3; i++) call(Animal.get_snacks, &d);
+  call(Animal.get_snacks, &p);
+  call(Animal.feed, &d, 1);
+
+  DynAnimal a = dyn(Animal, &p);
+  call(Animal.get_snacks, &a);
+  call(Animal.get_snacks, &a);
+  DynPet dp = dyn(Pet, &d);
+  call(Animal.get_snacks, &dp);
+  call(Pet.name, &dp);
+
+  const char *r = dump();
+  printf("%s", r);
+  const char *dyn_part = strstr(r, "dynamic:");
+  TEST(dyn_part != NULL, "report has a dynamic section");
+  TEST(strstr(r, "3  Dog.Animal.get_snacks\n") != NULL, "static count per type");
+  TEST(strstr(r, "1  Parrot.Animal.get_snacks\n") != NULL, "separate slot per type");
+  TEST(strstr(r, "1  Dog.Animal.feed\n") != NULL, "default method counted");
+  TEST(strstr(r, "2  DynAnimal.Animal.get_snacks\n") > dyn_part, "dynamic slot");
+  TEST(strstr(r, "1  DynPet.Pet.Animal.get_snacks\n") > dyn_part, "base method via derived object");
+  TEST(strstr(r, "1  DynPet.Pet.name\n") > dyn_part, "own method via derived object");
+  TEST(strstr(r, "Pet.name") > dyn_part, "no static Pet.name slot (never called)");
+
+  trait_profile_reset();
+  call(Animal.get_snacks, &d);
+  r = dump();
+  TEST(strstr(r, "1  Dog.Animal.get_snacks\n") != NULL, "reset clears counts");
+  TEST(strstr(r, "Parrot") == NULL, "zero slots are not printed");
+
+  printf("\n=== Results: %d/%d tests passed ===\n", passed, tests);
+  return tests == passed ? 0 : 1;
+}
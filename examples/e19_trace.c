@@ -0,0 +1,146 @@
+// clang-format off
+#define TRAIT_TRACE
+#define TRAIT_TRACE_RING 8
+#include "../trait.h"
+#include <stdio.h>
+#include <string.h>
+
+// -DTRAIT_TRACE (here: #define before the first include) compiles a sampler
+// into every dynamic call() wrapper.  It stays idle until a rate is set:
+//   trait_trace_set_rate(1);            // every dynamic call; 64 = every 64th
+//   trait_trace_dump_json(stdout);
+//   {"traceEvents":[
+//   {"name":"Animal.get_snacks","cat":"DynAnimal","ph":"i","s":"t",
+//    "ts":5120.250,"pid":1,"tid":1,"args":{"vtable":"0x5581..."}},
+//   ...
+// Static dispatch is never traced.  TRAIT_TRACE_RING (events kept per thread)
+// is shrunk to 8 here to show the ring wrapping.
+
+// ---- trait: Animal -----------------------------------------------------------
+#define AnimalSignature(Self)                    \
+  required(Self, int,  get_snacks)            \
+  defaults(Self, void, feed, int)
+#define Dynamic
+#define Trait Animal
+#include "../trait.h"
+
+#define For Default
+#define Impl Animal
+  void def(feed, int amount) { (void)self; (void)amount; }
+#include "../trait.h"
+
+
+// ---- trait: Pet (extends Animal) ---------------------------------------------
+#define PetSignature(Self)                       \
+  extends(Animal, Self)                         \
+  required(immutable(Self), const char *, name)
+#define Dynamic
+#define Trait Pet
+#include "../trait.h"
+
+#define For Default
+#define Impl Pet
+#include "../trait.h"
+
+
+// ---- type + impls ------------------------------------------------------------
+typedef struct { int snacks; } Dog;
+
+#define For Dog
+#define Impl Animal
+  int def(get_snacks) { return self->snacks; }
+#include "../trait.h"
+
+#define For Dog
+#define Impl Pet
+  const char *constdef(name) { (void)self; return "Rex"; }
+#include "../trait.h"
+
+
+// ---- main --------------------------------------------------------------------
+static int tests = 0, passed = 0;
+#define TEST(cond, msg) do { tests++; if (cond) { passed++; } \
+  else { printf("  FAIL: %s\n", msg); } } while(0)
+
+static char report[8192];
+static size_t report_len;
+
+static const char *dump(void (*fn)(FILE *)) {
+  FILE *f = tmpfile();
+  report_len = 0;
+  report[0] = '\0';
+  if (!f) return report;
+  fn(f);
+  rewind(f);
+  report_len = fread(report, 1, sizeof report - 1, f);
+  report[report_len] = '\0';
+  fclose(f);
+  return report;
+}
+
+static int count(const char *s, const char *needle) {
+  int n = 0;
+  for (; (s = strstr(s, needle)) != NULL; s++) n++;
+  return n;
+}
+
+int main(void) {
+  Dog d = { .snacks = 2 };
+  DynAnimal a = dyn(Animal, &d);
+  DynPet dp = dyn(Pet, &d);
+
+  printf("=== idle ===\n");
+  for (int i = 0; i < 4; i++) call(Animal.get_snacks, &a);
+  TEST(count(dump(trait_trace_dump_json), "\"name\"") == 0, "no events before a rate is set");
+
+  printf("\n=== every call ===\n");
+  trait_trace_set_rate(1);
+  call(Animal.get_snacks, &a);
+  call(Animal.feed, &a, 1);
+  call(Animal.get_snacks, &dp);
+  call(Pet.name, &dp);
+  call(Animal.get_snacks, &d);   // static dispatch: not traced
+  const char *r = dump(trait_trace_dump_json);
+  printf("%s", r);
+  TEST(strncmp(r, "{\"traceEvents\":[", 16) == 0, "chrome trace header");
+  TEST(count(r, "\"name\"") == 4, "four dynamic calls, static call skipped");
+  TEST(strstr(r, "\"name\":\"Animal.get_snacks\",\"cat\":\"DynAnimal\"") != NULL, "own method");
+  TEST(strstr(r, "\"name\":\"Animal.feed\"") != NULL, "default method");
+  TEST(strstr(r, "\"name\":\"Pet.Animal.get_snacks\",\"cat\":\"DynPet\"") != NULL,
+       "base method via derived object");
+  TEST(strstr(r, "\"tid\":1") != NULL, "first sampling thread is tid 1");
+  char vt[64];
+  snprintf(vt, sizeof vt, "\"vtable\":\"%p\"", (const void *)a.vt);
+  TEST(strstr(r, vt) != NULL, "vtable address recorded");
+  TEST(strstr(r, "Animal.get_snacks") < strstr(r, "Animal.feed"), "events in call order");
+
+  printf("\n=== sampling rate ===\n");
+  trait_trace_reset();
+  TEST(count(dump(trait_trace_dump_json), "\"name\"") == 0, "reset drops events");
+  trait_trace_set_rate(3);
+  for (int i = 0; i < 7; i++) call(Animal.get_snacks, &a);
+  TEST(count(dump(trait_trace_dump_json), "\"name\"") == 2, "every 3rd of 7 calls");
+
+  printf("\n=== ring wraps ===\n");
+  trait_trace_reset();
+  trait_trace_set_rate(1);
+  for (int i = 0; i < 20; i++) call(Animal.get_snacks, &a);
+  call(Pet.name, &dp);
+  r = dump(trait_trace_dump_json);
+  TEST(count(r, "\"name\"") == TRAIT_TRACE_RING, "only the last TRAIT_TRACE_RING kept");
+  TEST(strstr(r, "Pet.name") != NULL, "newest event survives");
+
+  printf("\n=== binary dump ===\n");
+  trait_trace_set_rate(0);
+  dump(trait_trace_dump_bin);
+  unsigned sites = 0;
+  memcpy(&sites, report + 8, sizeof sites);
+  TEST(memcmp(report, "TRTRACE1", 8) == 0, "magic");
+  TEST(sites >= 4, "site table lists the wrappers");
+  const char *p = report + 12;
+  for (unsigned i = 0; i < 3 * sites; i++) p += strlen(p) + 1;
+  TEST((size_t)(report + report_len - p) == TRAIT_TRACE_RING * 24, "24-byte records");
+
+  printf("\n=== Results: %d/%d tests passed ===\n", passed, tests);
+  return tests == passed ? 0 : 1;
+}
@@ -0,0 +1,118 @@
+// clang-format off
+#define TRAIT_TRACE
+#define Hint_Shape_area (Square_Shape_area)
+// Count the calls that take the guarded direct path.
+static int hint_hits = 0;
+#define TRAIT_HINT_HIT(Fn) (hint_hits++)
+#include "../trait.h"
+#include <stdio.h>
+#include <string.h>
+
+// Profile-guided devirtualization.  pgo.sh turns a trait_trace_dump_pgo()
+// profile into hints naming the hottest implementation of each method:
+//   #define Hint_Shape_area (Square_Shape_area)
+// Defined before the trait, a hint makes every DynSD wrapper of Shape.area
+// check the vtable slot and call Square_Shape_area directly on a match:
+//   if (self->vt->area == Square_Shape_area) return Square_Shape_area(self->self);
+//   return self->vt->area(self->self);
+// Other implementations still go through the vtable, so results never change.
+
+// ---- trait: Shape ------------------------------------------------------------
+#define ShapeSignature(Self)                     \
+  required(immutable(Self), int, area)          \
+  required(Self, void, grow, int)
+#define Dynamic
+#define Trait Shape
+#include "../trait.h"
+
+#define For Default
+#define Impl Shape
+#include "../trait.h"
+
+
+// ---- trait: Solid (extends Shape) --------------------------------------------
+#define SolidSignature(Self)                     \
+  extends(Shape, Self)                          \
+  required(immutable(Self), int, volume)
+#define Dynamic
+#define Trait Solid
+#include "../trait.h"
+
+#define For Default
+#define Impl Solid
+#include "../trait.h"
+
+
+// ---- types + impls -----------------------------------------------------------
+typedef struct { int side; } Square;
+typedef struct { int r; } Circle;
+
+#define For Square
+#define Impl Shape
+  int constdef(area) { return self->side * self->side; }
+  void def(grow, int by) { self->side += by; }
+#include "../trait.h"
+
+#define For Square
+#define Impl Solid
+  int constdef(volume) { return self->side * self->side * self->side; }
+#include "../trait.h"
+
+#define For Circle
+#define Impl Shape
+  int constdef(area) { return 3 * self->r * self->r; }
+  void def(grow, int by) { self->r += by; }
+#include "../trait.h"
+
+
+// ---- main --------------------------------------------------------------------
+static int tests = 0, passed = 0;
+#define TEST(cond, msg) do { tests++; if (cond) { passed++; } \
+  else { printf("  FAIL: %s\n", msg); } } while(0)
+
+static char report[4096];
+
+static const char *dump(void) {
+  FILE *f = tmpfile();
+  if (!f) return "";
+  trait_trace_dump_pgo(f);
+  rewind(f);
+  size_t n = fread(report, 1, sizeof report - 1, f);
+  report[n] = '\0';
+  fclose(f);
+  return report;
+}
+
+int main(void) {
+  Square sq = { 2 };
+  Circle c = { 1 };
+  DynShape shapes[] = { dyn(Shape, &sq), dyn(Shape, &c) };
+  DynSolid solid = dyn(Solid, &sq);
+
+  printf("=== hinted dispatch ===\n");
+  TEST(call(Shape.area, &shapes[0]) == 4 && hint_hits == 1, "hinted implementation (guard hit)");
+  TEST(call(Shape.area, &shapes[1]) == 3 && hint_hits == 1, "other implementation (guard miss)");
+  TEST(call(Shape.area, &solid) == 4 && hint_hits == 2, "replayed base method is hinted too");
+  call(Shape.grow, &shapes[1], 1);
+  TEST(call(Shape.area, &shapes[1]) == 12 && hint_hits == 2, "unhinted method unchanged");
+
+  printf("\n=== profile for pgo.sh ===\n");
+  trait_trace_set_rate(1);
+  for (int i = 0; i < 4; i++) call(Shape.area, &shapes[0]);
+  call(Shape.area, &shapes[1]);
+  call(Solid.volume, &solid);
+  trait_trace_set_rate(0);
+  const char *r = dump();
+  printf("%s", r);
+  char line[128];
+  TEST(strncmp(r, "anchor ", 7) == 0, "anchor line first");
+  snprintf(line, sizeof line, "4 DynShape Shape area %p\n", (const void *)shapes[0].vt);
+  TEST(strstr(r, line) != NULL, "count per (site, vtable): Square");
+  snprintf(line, sizeof line, "1 DynShape Shape area %p\n", (const void *)shapes[1].vt);
+  TEST(strstr(r, line) != NULL, "count per (site, vtable): Circle");
+  snprintf(line, sizeof line, "1 DynSolid Solid volume %p\n", (const void *)solid.vt);
+  TEST(strstr(r, line) != NULL, "derived trait object site");
+
+  printf("\n=== Results: %d/%d tests passed ===\n", passed, tests);
+  return tests == passed ? 0 : 1;
+}
@@ -0,0 +1,89 @@
+// clang-format off
+#include "../trait.h"
+#include <assert.h>
+#include <stdio.h>
+
+// Registry size as compile-time constants:
+//   TRAIT_SD_SLOTS, TRAIT_TT_SLOTS   slots used so far in this TU (valid in #if)
+//   trait_methods(T)                 methods of T, inherited ones included
+//   trait_dyn_slots(T)               SD slots T's DynSD wrappers took
+// call() and dyn() expand _Generic chains over these slots, so a TU can cap
+// them.  -DTRAIT_STATS also prints a #pragma message per trait and impl.
+
+// ---- trait: Animal -----------------------------------------------------------
+#define AnimalSignature(Self)                    \
+  required(Self, int,  get_snacks)            \
+  defaults(Self, void, feed, int)
+#define Dynamic
+#define Trait Animal
+#include "../trait.h"
+
+#define For Default
+#define Impl Animal
+  void def(feed, int amount) { (void)self; (void)amount; }
+#include "../trait.h"
+
+// Animal's DynSD wrappers: one slot per method.
+#if TRAIT_SD_SLOTS != 2
+#error "expected 2 SD slots after Animal"
+#endif
+
+
+// ---- trait: Pet (extends Animal) ---------------------------------------------
+#define PetSignature(Self)                       \
+  extends(Animal, Self)                         \
+  required(immutable(hot(Self)), const char *, name)
+#define Dynamic
+#define Trait Pet
+#include "../trait.h"
+
+#define For Default
+#define Impl Pet
+#include "../trait.h"
+
+
+// ---- type + impls ------------------------------------------------------------
+typedef struct { int snacks; } Dog;
+
+#define For Dog
+#define Impl Animal
+  int def(get_snacks) { return self->snacks; }
+#include "../trait.h"
+
+#define For Dog
+#define Impl Pet
+  const char *constdef(name) { (void)self; return "Rex"; }
+#include "../trait.h"
+
+// A budget check, as a large TU would write it.
+#if TRAIT_SD_SLOTS > 64 || TRAIT_TT_SLOTS > 8
+#error "registry budget exceeded"
+#endif
+
+static_assert(trait_methods(Pet) == trait_methods(Animal) + 1, "Pet adds one method");
+
+
+// ---- main --------------------------------------------------------------------
+static int tests = 0, passed = 0;
+#define TEST(cond, msg) do { tests++; if (cond) { passed++; } \
+  else { printf("  FAIL: %s\n", msg); } } while(0)
+
+int main(void) {
+  printf("SD slots %d, TT slots %d\n", TRAIT_SD_SLOTS, TRAIT_TT_SLOTS);
+
+  printf("=== methods ===\n");
+  TEST(trait_methods(Animal) == 2, "Animal: required + default");
+  TEST(trait_methods(Pet) == 3, "Pet: own + inherited, hot() counted once");
+
+  printf("\n=== DynSD slots ===\n");
+  TEST(trait_dyn_slots(Animal) == 2, "one per method");
+  TEST(trait_dyn_slots(Pet) == 4, "own, two replayed base methods, one upcast");
+
+  printf("\n=== totals ===\n");
+  // 6 DynSD + Dog: 2 Animal, 1 Pet static slots, 1 implements() marker each.
+  TEST(TRAIT_SD_SLOTS == 11, "SD slots");
+  TEST(TRAIT_TT_SLOTS == 2, "TT slots: Dog as Animal, Dog as Pet");
+
+  printf("\n=== Results: %d/%d tests passed ===\n", passed, tests);
+  return tests == passed ? 0 : 1;
+}
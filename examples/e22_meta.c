@@ -0,0 +1,155 @@
+// clang-format off
+#define TRAIT_META
+#include "../trait.h"
+#include <stdio.h>
+#include <string.h>
+
+// Every dynamic trait carries a static const description of its vtable:
+//   trait_meta(Pet)->methods[i]  {name, offset, is_const, arity}
+//   trait_meta(Pet)->bases[i]    {trait_meta(Animal), offset, shared}
+// trait_meta_lookup(m, vt, "feed") resolves a method by name, bases included,
+// which is enough to drive a name-keyed dispatcher (RPC, scripting) without a
+// hand-kept string table.  -DTRAIT_META (here: #define before the first
+// include) also lists every (type, vtable) implementing a trait.
+
+// ---- trait: Animal -----------------------------------------------------------
+#define AnimalSignature(Self)                    \
+  required(Self, int,  get_snacks)            \
+  defaults(Self, void, feed, int)
+#define Dynamic
+#define Trait Animal
+#include "../trait.h"
+
+#define For Default
+#define Impl Animal
+  void def(feed, int amount) { (void)self; (void)amount; }
+#include "../trait.h"
+
+
+// ---- trait: Named ------------------------------------------------------------
+#define NamedSignature(Self)                     \
+  required(immutable(Self), const char *, name)
+#define Dynamic
+#define Trait Named
+#include "../trait.h"
+
+#define For Default
+#define Impl Named
+#include "../trait.h"
+
+
+// ---- trait: Pet (Animal embedded, Named shared, hot play) --------------------
+#define PetSignature(Self)                       \
+  extends(Animal, Self)                         \
+  extends_shared(Named, Self)                   \
+  required(Self, int, rename, const char *, int) \
+  required(hot(immutable(Self)), int, play)
+#define Dynamic
+#define Trait Pet
+#include "../trait.h"
+
+#define For Default
+#define Impl Pet
+#include "../trait.h"
+
+
+// ---- types + impls -----------------------------------------------------------
+typedef struct { int snacks; const char *name; } Dog;
+typedef struct { int snacks; long lives; } Cat;
+
+#define For Dog
+#define Impl Animal
+  int def(get_snacks) { return self->snacks; }
+  void def(feed, int amount) { self->snacks += amount; }
+#define Override_Dog_Animal_feed 1
+#include "../trait.h"
+
+#define For Dog
+#define Impl Named
+  const char *constdef(name) { return self->name; }
+#include "../trait.h"
+
+#define For Dog
+#define Impl Pet
+  int def(rename, const char *name, int keep) { if (!keep) self->name = name; return !keep; }
+  int constdef(play) { return self->snacks * 10; }
+#include "../trait.h"
+
+#define For Cat
+#define Impl Animal
+  int def(get_snacks) { return (int)self->lives; }
+#include "../trait.h"
+
+
+// ---- main --------------------------------------------------------------------
+static int tests = 0, passed = 0;
+#define TEST(cond, msg) do { tests++; if (cond) { passed++; } \
+  else { printf("  FAIL: %s\n", msg); } } while(0)
+
+static const struct trait_method_meta *row(const struct trait_meta *m, const char *name) {
+  for (unsigned i = 0; i < m->n_methods; i++)
+    if (strcmp(m->methods[i].name, name) == 0) return &m->methods[i];
+  return NULL;
+}
+
+// A name-keyed dispatcher for zero-argument int methods.
+static int invoke(const struct trait_meta *m, void *self, const void *vt,
+                  const char *name, int *out) {
+  int (*fn)(void *) = (int (*)(void *))trait_meta_lookup(m, vt, name);
+  if (!fn) return 0;
+  *out = fn(self);
+  return 1;
+}
+
+int main(void) {
+  Dog d = { .snacks = 2, .name = "Rex" };
+  DynPet p = dyn(Pet, &d);
+  const struct trait_meta *m = trait_meta(Pet);
+
+  printf("=== method table ===\n");
+  for (unsigned i = 0; i < m->n_methods; i++)
+    printf("  %-8s offset %2zu  const %d  arity %d\n", m->methods[i].name,
+           m->methods[i].offset, m->methods[i].is_const, m->methods[i].arity);
+  TEST(strcmp(m->name, "Pet") == 0 && m->vtable_size == sizeof(Pet_vtable), "trait name and size");
+  TEST(m->n_methods == 2, "own methods only");
+  TEST(strcmp(m->methods[0].name, "rename") == 0, "signature order");
+  TEST(row(m, "play")->offset == offsetof(Pet_vtable, play), "offset follows hot layout");
+  TEST(row(m, "play")->is_const && !row(m, "rename")->is_const, "constness");
+  TEST(row(m, "rename")->arity == 2 && row(m, "play")->arity == 0, "arity excludes self");
+
+  printf("\n=== bases ===\n");
+  TEST(m->n_bases == 2, "two bases");
+  TEST(m->bases[0].base == trait_meta(Animal) && !m->bases[0].shared &&
+       m->bases[0].offset == offsetof(Pet_vtable, Animal), "embedded Animal");
+  TEST(m->bases[1].base == trait_meta(Named) && m->bases[1].shared, "shared Named");
+  TEST(trait_meta(Animal)->methods[1].arity == 1, "base rows live in the base table");
+
+  printf("\n=== lookup by name ===\n");
+  int v = 0;
+  TEST(invoke(m, &d, p.vt, "play", &v) && v == 20, "own method");
+  TEST(invoke(m, &d, p.vt, "get_snacks", &v) && v == 2, "embedded base method");
+  const char *(*nm)(const void *) =
+      (const char *(*)(const void *))trait_meta_lookup(m, p.vt, "name");
+  TEST(nm && strcmp(nm(&d), "Rex") == 0, "shared base method");
+  void (*feed)(void *, int) = (void (*)(void *, int))trait_meta_lookup(m, p.vt, "feed");
+  feed(&d, 3);
+  TEST(d.snacks == 5, "overridden default resolves to the impl");
+  TEST(trait_meta_lookup(m, p.vt, "fly") == NULL, "unknown name");
+
+  printf("\n=== implementing types ===\n");
+  int dog = 0, cat = 0;
+  for (const struct trait_impl_meta *const *it = trait_impls_begin(Animal);
+       it < trait_impls_end(Animal); it++) {
+    printf("  %s: vtable %p, %zu bytes\n", (*it)->type, (*it)->vtable, (*it)->size);
+    if (strcmp((*it)->type, "Dog") == 0)
+      dog = (*it)->vtable == (const void *)&Dog_Animal_vtable && (*it)->size == sizeof(Dog);
+    if (strcmp((*it)->type, "Cat") == 0)
+      cat = (*it)->vtable == (const void *)&Cat_Animal_vtable && (*it)->trait == trait_meta(Animal);
+  }
+  TEST(trait_impls_end(Animal) - trait_impls_begin(Animal) == 2, "two Animal impls");
+  TEST(dog && cat, "records carry vtable, size and trait");
+  TEST(trait_impls_end(Pet) - trait_impls_begin(Pet) == 1, "one Pet impl");
+
+  printf("\n=== Results: %d/%d tests passed ===\n", passed, tests);
+  return tests == passed ? 0 : 1;
+}
@@ -0,0 +1,117 @@
+// clang-format off
+#define TRAIT_META
+#include "../trait.h"
+#include <stdio.h>
+#include <string.h>
+
+// With -DTRAIT_META (here: #define before the first include) every impl block
+// drops a {type, trait, vtable, sizeof(type)} record into the trait_impls
+// section.  The linker concatenates the records of all TUs and static
+// libraries, so the program can enumerate its impls with no constructors:
+//   for (const struct trait_impl_meta *const *it = trait_registry_begin();
+//        it < trait_registry_end(); it++) ...
+//   trait_registry_dump(stdout);   // "Dog Animal 0x55d1... 16"
+// Below, a plugin-style factory picks a type by name from the registry.
+
+// ---- trait: Animal -----------------------------------------------------------
+#define AnimalSignature(Self)                    \
+  required(immutable(Self), int, legs)
+#define Dynamic
+#define Trait Animal
+#include "../trait.h"
+
+#define For Default
+#define Impl Animal
+#include "../trait.h"
+
+
+// ---- trait: Named ------------------------------------------------------------
+#define NamedSignature(Self)                     \
+  required(immutable(Self), const char *, name)
+#define Dynamic
+#define Trait Named
+#include "../trait.h"
+
+#define For Default
+#define Impl Named
+#include "../trait.h"
+
+
+// ---- types + impls -----------------------------------------------------------
+typedef struct { int age; } Dog;
+typedef struct { int age; char wings; } Bird;
+
+#define For Dog
+#define Impl Animal
+  int constdef(legs) { (void)self; return 4; }
+#include "../trait.h"
+
+#define For Dog
+#define Impl Named
+  const char *constdef(name) { (void)self; return "dog"; }
+#include "../trait.h"
+
+#define For Bird
+#define Impl Animal
+  int constdef(legs) { (void)self; return 2; }
+#include "../trait.h"
+
+
+// ---- trait: Quiet (static: no vtable, never registered) ----------------------
+#define QuietSignature(Self)                     \
+  required(immutable(Self), int, volume)
+#define Trait Quiet
+#include "../trait.h"
+
+#define For Dog
+#define Impl Quiet
+  int constdef(volume) { (void)self; return 0; }
+#include "../trait.h"
+
+
+// ---- main --------------------------------------------------------------------
+static int tests = 0, passed = 0;
+#define TEST(cond, msg) do { tests++; if (cond) { passed++; } \
+  else { printf("  FAIL: %s\n", msg); } } while(0)
+
+// Builds a DynAnimal for a type known only by name, e.g. read from a config.
+static int make_animal(const char *type, void *storage, DynAnimal *out) {
+  for (const struct trait_impl_meta *const *it = trait_registry_begin();
+       it < trait_registry_end(); it++)
+    if (strcmp((*it)->type, type) == 0 && (*it)->trait == trait_meta(Animal)) {
+      memset(storage, 0, (*it)->size);
+      out->self = storage;
+      out->vt = (const Animal_vtable *)(*it)->vtable;
+      return 1;
+    }
+  return 0;
+}
+
+static int count(const char *type, const char *trait) {
+  int n = 0;
+  for (const struct trait_impl_meta *const *it = trait_registry_begin();
+       it < trait_registry_end(); it++)
+    n += strcmp((*it)->type, type) == 0 && strcmp((*it)->trait->name, trait) == 0;
+  return n;
+}
+
+int main(void) {
+  printf("=== registry ===\n");
+  trait_registry_dump(stdout);
+  TEST(trait_registry_end() - trait_registry_begin() == 3, "three dynamic impls");
+  TEST(count("Dog", "Animal") == 1 && count("Dog", "Named") == 1, "Dog: Animal and Named");
+  TEST(count("Bird", "Animal") == 1, "Bird: Animal");
+  TEST(count("Dog", "Quiet") == 0, "static trait impls are not registered");
+  TEST(trait_impls_end(Animal) - trait_impls_begin(Animal) == 2, "per-trait list agrees");
+
+  printf("\n=== factory by type name ===\n");
+  union { Dog d; Bird b; } storage;
+  DynAnimal a;
+  TEST(make_animal("Bird", &storage, &a) && call(Animal.legs, &a) == 2, "Bird from registry");
+  TEST(make_animal("Dog", &storage, &a) && a.vt == dyn(Animal, &storage.d).vt,
+       "registry vtable is the dyn() vtable");
+  TEST(!make_animal("Cat", &storage, &a), "unknown type");
+
+  printf("\n=== Results: %d/%d tests passed ===\n", passed, tests);
+  return tests == passed ? 0 : 1;
+}
@@ -0,0 +1,147 @@
+// clang-format off
+#define TRAIT_META
+#include "../trait.h"
+#include <stdio.h>
+#include <string.h>
+
+// trait_lookup(type_id, Trait) returns the Trait vtable of the type whose id
+// is type_id, or NULL, with a single probe into a perfect hash built from the
+// trait_impls registry on first use.  Type ids are stable 64-bit constants,
+// hashed over the whole name:
+//   static const unsigned long long TAG_CIRCLE = trait_type_id(Circle);
+//   trait_type_id_of("Circle") == TAG_CIRCLE     // same value at runtime
+// A deserializer reads the tag off the wire and builds the trait object
+// without a per-trait switch over every known type.
+
+// ---- trait: Shape ------------------------------------------------------------
+#define ShapeSignature(Self)                     \
+  required(immutable(Self), int, area)          \
+  required(Self, void, load, const int *)
+#define Dynamic
+#define Trait Shape
+#include "../trait.h"
+
+#define For Default
+#define Impl Shape
+#include "../trait.h"
+
+
+// ---- trait: Named ------------------------------------------------------------
+#define NamedSignature(Self)                     \
+  required(immutable(Self), const char *, name)
+#define Dynamic
+#define Trait Named
+#include "../trait.h"
+
+#define For Default
+#define Impl Named
+#include "../trait.h"
+
+
+// ---- types + impls -----------------------------------------------------------
+typedef struct { int r; } Circle;
+typedef struct { int w, h; } Rect;
+typedef struct { int s; } Square;
+typedef struct { int b, h; } Triangle;
+
+#define For Circle
+#define Impl Shape
+  int constdef(area) { return 3 * self->r * self->r; }
+  void def(load, const int *v) { self->r = v[0]; }
+#include "../trait.h"
+
+#define For Circle
+#define Impl Named
+  const char *constdef(name) { (void)self; return "circle"; }
+#include "../trait.h"
+
+#define For Rect
+#define Impl Shape
+  int constdef(area) { return self->w * self->h; }
+  void def(load, const int *v) { self->w = v[0]; self->h = v[1]; }
+#include "../trait.h"
+
+#define For Square
+#define Impl Shape
+  int constdef(area) { return self->s * self->s; }
+  void def(load, const int *v) { self->s = v[0]; }
+#include "../trait.h"
+
+#define For Triangle
+#define Impl Shape
+  int constdef(area) { return self->b * self->h / 2; }
+  void def(load, const int *v) { self->b = v[0]; self->h = v[1]; }
+#include "../trait.h"
+
+// Long names that agree in their first 32 bytes and their length.
+typedef struct { int v; } VeryLongSubsystemPrefix_WidgetKind_Alpha;
+typedef struct { int v; } VeryLongSubsystemPrefix_WidgetKind_Gamma;
+
+#define For VeryLongSubsystemPrefix_WidgetKind_Alpha
+#define Impl Named
+  const char *constdef(name) { (void)self; return "alpha"; }
+#include "../trait.h"
+
+#define For VeryLongSubsystemPrefix_WidgetKind_Gamma
+#define Impl Named
+  const char *constdef(name) { (void)self; return "gamma"; }
+#include "../trait.h"
+
+
+// ---- main --------------------------------------------------------------------
+static int tests = 0, passed = 0;
+#define TEST(cond, msg) do { tests++; if (cond) { passed++; } \
+  else { printf("  FAIL: %s\n", msg); } } while(0)
+
+static const unsigned long long TAG_CIRCLE = trait_type_id(Circle);
+
+// Wire format: type name, then up to two ints.
+struct message { const char *type; int v[2]; };
+
+static int area_of(const struct message *m, void *buf) {
+  const Shape_vtable *vt = trait_lookup(trait_type_id_of(m->type), Shape);
+  if (!vt) return -1;
+  DynShape s = { buf, vt };
+  call(Shape.load, &s, m->v);
+  return call(Shape.area, &s);
+}
+
+int main(void) {
+  union { Circle c; Rect r; Square s; Triangle t; } buf;
+
+  printf("=== type ids ===\n");
+  printf("  Circle = %016llx\n", TAG_CIRCLE);
+  TEST(trait_type_id_of("Circle") == TAG_CIRCLE, "runtime id matches the constant");
+  TEST(trait_type_id(Rect) != TAG_CIRCLE && trait_type_id(Square) != trait_type_id(Rect),
+       "distinct names, distinct ids");
+  TEST(trait_type_id(Shape) == trait_type_id_of("Shape"), "trait names hash the same way");
+  TEST(trait_type_id(VeryLongSubsystemPrefix_WidgetKind_Alpha)
+       != trait_type_id(VeryLongSubsystemPrefix_WidgetKind_Gamma), "the whole name is hashed");
+
+  printf("\n=== lookup ===\n");
+  TEST(trait_lookup(TAG_CIRCLE, Shape) == &Circle_Shape_vtable, "Circle as Shape");
+  TEST(trait_lookup(TAG_CIRCLE, Named) == &Circle_Named_vtable, "Circle as Named");
+  TEST(trait_lookup(trait_type_id(Rect), Named) == NULL, "Rect is not Named");
+  TEST(trait_lookup(trait_type_id_of("Hexagon"), Shape) == NULL, "unknown type");
+  TEST(trait_lookup(trait_type_id(VeryLongSubsystemPrefix_WidgetKind_Gamma), Named)
+       == &VeryLongSubsystemPrefix_WidgetKind_Gamma_Named_vtable, "long names stay apart");
+  TEST(trait_lookup_table->n == 7 && (1u << trait_lookup_table->bits) < 2 * 7,
+       "one key per impl, fewer than two slots per key");
+
+  printf("\n=== deserializer ===\n");
+  static const struct message wire[] = {
+    {"Rect", {3, 4}}, {"Circle", {2, 0}}, {"Triangle", {6, 5}}, {"Square", {5, 0}},
+  };
+  int total = 0;
+  for (size_t i = 0; i < sizeof wire / sizeof *wire; i++) {
+    int a = area_of(&wire[i], &buf);
+    printf("  %-8s area %d\n", wire[i].type, a);
+    total += a;
+  }
+  TEST(total == 12 + 12 + 15 + 25, "areas through looked-up vtables");
+  struct message bad = {"Hexagon", {1, 1}};
+  TEST(area_of(&bad, &buf) == -1, "unknown tag rejected");
+
+  printf("\n=== Results: %d/%d tests passed ===\n", passed, tests);
+  return tests == passed ? 0 : 1;
+}
@@ -0,0 +1,138 @@
+// clang-format off
+#define TRAIT_META
+#include "../trait.h"
+#include <stdio.h>
+#include <string.h>
+
+// try_dyn(Trait, &obj) asks a trait object whether its concrete type also
+// implements Trait, without knowing that type:
+//   DynShow s = try_dyn(Show, &animal);
+//   if (s.vt) call(Show.show, &s);
+// The type is recovered from the source vtable's address (the -DTRAIT_META
+// registry knows every vtable's extent), so vtables keep their layout.  Each
+// (source vtable, target trait) answer is cached: the next cast is one load,
+// and a miss takes over its cache slot.
+
+// ---- trait: Animal -----------------------------------------------------------
+#define AnimalSignature(Self)                    \
+  required(immutable(Self), int, legs)
+#define Dynamic
+#define Trait Animal
+#include "../trait.h"
+
+#define For Default
+#define Impl Animal
+#include "../trait.h"
+
+
+// ---- trait: Show -------------------------------------------------------------
+#define ShowSignature(Self)                      \
+  required(immutable(Self), const char *, show)
+#define Dynamic
+#define Trait Show
+#include "../trait.h"
+
+#define For Default
+#define Impl Show
+#include "../trait.h"
+
+
+// ---- trait: Pet (extends Animal) ---------------------------------------------
+#define PetSignature(Self)                       \
+  extends(Animal, Self)                         \
+  required(Self, int, pat)
+#define Dynamic
+#define Trait Pet
+#include "../trait.h"
+
+#define For Default
+#define Impl Pet
+#include "../trait.h"
+
+
+// ---- types + impls -----------------------------------------------------------
+typedef struct { int pats; } Dog;
+typedef struct { int lives; } Cat;
+
+#define For Dog
+#define Impl Animal
+  int constdef(legs) { (void)self; return 4; }
+#include "../trait.h"
+
+#define For Dog
+#define Impl Show
+  const char *constdef(show) { (void)self; return "dog"; }
+#include "../trait.h"
+
+#define For Dog
+#define Impl Pet
+  int def(pat) { return ++self->pats; }
+#include "../trait.h"
+
+#define For Cat
+#define Impl Animal
+  int constdef(legs) { return self->lives > 0 ? 4 : 0; }
+#include "../trait.h"
+
+
+// ---- main --------------------------------------------------------------------
+static int tests = 0, passed = 0;
+#define TEST(cond, msg) do { tests++; if (cond) { passed++; } \
+  else { printf("  FAIL: %s\n", msg); } } while(0)
+
+static const char *describe(DynAnimal a) {
+  DynShow s = try_dyn(Show, &a);
+  return s.vt ? call(Show.show, &s) : "(no Show)";
+}
+
+static int cached(void) {
+  int n = 0;
+  for (int i = 0; i < TRAIT_ITAB_CACHE; i++) n += trait_itab_cache[i].src != NULL;
+  return n;
+}
+
+static const void *cache_entry(const void *src, const void *dst) {
+  for (int i = 0; i < TRAIT_ITAB_CACHE; i++)
+    if (trait_itab_cache[i].src == src && trait_itab_cache[i].dst == dst)
+      return &trait_itab_cache[i];
+  return NULL;
+}
+
+int main(void) {
+  Dog d = { 0 };
+  Cat c = { 9 };
+  DynAnimal da = dyn(Animal, &d), ca = dyn(Animal, &c);
+
+  printf("=== cast between unrelated traits ===\n");
+  const char *dog = describe(da);   // first cast: its cache slot is free
+  printf("  dog: %s\n  cat: %s\n", dog, describe(ca));
+  TEST(strcmp(dog, "dog") == 0, "Animal -> Show");
+  TEST(try_dyn(Show, &ca).vt == NULL, "Cat has no Show");
+  DynShow s = try_dyn(Show, &da);
+  TEST(s.self == &d && s.vt == &Dog_Show_vtable, "same object, Dog's Show vtable");
+  DynPet p = try_dyn(Pet, &s);
+  TEST(p.vt && call(Pet.pat, &p) == 1 && d.pats == 1, "Show -> Pet (downcast)");
+
+  printf("\n=== base views ===\n");
+  DynAnimal up = upcast(Animal, &p);
+  TEST(up.vt == &Dog_Pet_vtable.Animal, "upcast points inside Pet's vtable");
+  TEST(try_dyn(Show, &up).vt == &Dog_Show_vtable, "resolved from an embedded base");
+  TEST(try_dyn(Animal, &s).vt == &Dog_Animal_vtable, "back to Animal");
+
+  printf("\n=== itab cache ===\n");
+  int before = cached();
+  for (int i = 0; i < 100; i++) (void)try_dyn(Show, &da);
+  TEST(cached() == before, "repeated casts add no entries");
+  TEST(cache_entry(da.vt, &Dog_Show_vtable) != NULL, "first cast landed in the cache");
+  struct trait_itab *slot = ___trait_itab_slot(da.vt, trait_type_id(Show));
+  slot->src = &c;                               // another pair took the slot
+  TEST(try_dyn(Show, &da).vt == &Dog_Show_vtable && slot->src == da.vt && !(slot->seq & 1),
+       "a miss replaces the entry in its slot");
+  DynAnimal *next = &da;
+  s = try_dyn(Show, next++);
+  TEST(s.vt == &Dog_Show_vtable && next == &da + 1, "obj is evaluated once");
+  TEST(trait_type_id_of_vtable(&c) == 0, "non-vtable address has no type");
+
+  printf("\n=== Results: %d/%d tests passed ===\n", passed, tests);
+  return tests == passed ? 0 : 1;
+}
@@ -0,0 +1,127 @@
+// clang-format off
+#include "../traits/ord.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// traits/ord.h declares a static Ord trait (int cmp(const Self *, const Self *))
+// and, for every `#define Ordered T` + include, monomorphized algorithms over
+// it: trait_sort (introsort), trait_bsearch / trait_lower_bound,
+// trait_nth_element (quickselect) and trait_merge (stable).  cmp is resolved
+// at compile time, so it inlines where qsort makes an indirect call per
+// comparison.  int, long and double come with an Ord impl.
+
+// ---- types + impls -----------------------------------------------------------
+typedef struct { int key, seq; } Rec;
+
+#define For Rec
+#define Impl Ord
+  int constdef(cmp, const Rec *other) { return (self->key > other->key) - (self->key < other->key); }
+#include "../trait.h"
+
+#define Ordered Rec
+#include "../traits/ord.h"
+
+#define Ordered int
+#include "../traits/ord.h"
+
+#define Ordered double
+#include "../traits/ord.h"
+
+
+// ---- trait: Shape (dynamic, impls written after the static Ord) --------------
+#define ShapeSignature(Self)                     \
+  required(immutable(Self), int, area)
+#define Dynamic
+#define Trait Shape
+#include "../trait.h"
+
+#define For Default
+#define Impl Shape
+#include "../trait.h"
+
+typedef struct { int w, h; } Box;
+
+#define For Box
+#define Impl Shape
+  int constdef(area) { return self->w * self->h; }
+#include "../trait.h"
+
+
+// ---- main --------------------------------------------------------------------
+static int tests = 0, passed = 0;
+#define TEST(cond, msg) do { tests++; if (cond) { passed++; } \
+  else { printf("  FAIL: %s\n", msg); } } while(0)
+
+static int int_cmp(const void *a, const void *b) {
+  int x = *(const int *)a, y = *(const int *)b;
+  return (x > y) - (x < y);
+}
+
+static unsigned rng = 12345;
+static int next(int mod) { rng = rng * 1103515245u + 12345u; return (int)((rng >> 8) % (unsigned)mod); }
+
+#define N 20000
+static int a[N], b[N];
+
+static int same(const int *x, const int *y, size_t n) {
+  for (size_t i = 0; i < n; i++) if (x[i] != y[i]) return 0;
+  return 1;
+}
+
+int main(void) {
+  printf("=== trait_sort vs qsort ===\n");
+  for (int i = 0; i < N; i++) a[i] = b[i] = next(1000000);
+  trait_sort(int, a, N);
+  qsort(b, N, sizeof *b, int_cmp);
+  TEST(same(a, b, N), "random ints sort like qsort");
+  for (int i = 0; i < N; i++) a[i] = b[i] = next(4);
+  trait_sort(int, a, N);
+  qsort(b, N, sizeof *b, int_cmp);
+  TEST(same(a, b, N), "heavy duplicates");
+  for (int i = 0; i < N; i++) a[i] = N - i;
+  trait_sort(int, a, N);
+  TEST(trait_is_sorted(int, a, N) && a[0] == 1, "reversed input");
+  for (int i = 0; i < N; i++) a[i] = i % 2 ? i : N - i;   // organ pipe-ish
+  trait_sort(int, a, N);
+  TEST(trait_is_sorted(int, a, N), "interleaved input");
+  double d[] = { 2.5, -1.0, 3.25, 0.0, -7.5 };
+  trait_sort(double, d, 5);
+  TEST(d[0] == -7.5 && d[4] == 3.25 && trait_is_sorted(double, d, 5), "builtin double impl");
+
+  printf("\n=== search ===\n");
+  for (int i = 0; i < N; i++) a[i] = 2 * i;                // evens
+  int key = 4242, odd = 4243, big = 2 * N;
+  const int *hit = trait_bsearch(int, a, N, &key);
+  TEST(hit && *hit == 4242 && hit - a == 2121, "bsearch finds an element");
+  TEST(trait_bsearch(int, a, N, &odd) == NULL, "bsearch misses");
+  TEST(trait_lower_bound(int, a, N, &odd) == 2122 &&
+       trait_lower_bound(int, a, N, &big) == N, "lower_bound");
+
+  printf("\n=== nth_element ===\n");
+  for (int i = 0; i < N; i++) a[i] = b[i] = next(1000000);
+  qsort(b, N, sizeof *b, int_cmp);
+  int ok = 1;
+  for (size_t k = 0; k < N; k += N / 7) {
+    trait_nth_element(int, a, N, k);
+    ok &= a[k] == b[k];
+    for (size_t i = 0; i < k; i++) ok &= a[i] <= a[k];
+    for (size_t i = k + 1; i < N; i++) ok &= a[i] >= a[k];
+  }
+  TEST(ok, "k-th element in place, partitioned around it");
+
+  printf("\n=== merge (structs, stable) ===\n");
+  Rec x[] = { {1, 0}, {3, 1}, {3, 2}, {8, 3} }, y[] = { {0, 10}, {3, 11}, {9, 12} }, out[7];
+  trait_merge(Rec, x, 4, y, 3, out);
+  for (int i = 0; i < 7; i++) printf("  {%d,%d}", out[i].key, out[i].seq);
+  printf("\n");
+  TEST(trait_is_sorted(Rec, out, 7), "merged output sorted");
+  TEST(out[2].seq == 1 && out[3].seq == 2 && out[4].seq == 11, "ties keep left before right");
+
+  printf("\n=== dynamic traits still dynamic ===\n");
+  Box bx = { 3, 4 };
+  DynShape s = dyn(Shape, &bx);
+  TEST(call(Shape.area, &s) == 12, "dyn impl after the static Ord");
+
+  printf("\n=== Results: %d/%d tests passed ===\n", passed, tests);
+  return tests == passed ? 0 : 1;
+}
@@ -0,0 +1,139 @@
+// clang-format off
+#include "../traits/hash.h"
+#include <stdio.h>
+#include <string.h>
+
+// traits/hash.h declares static Hash and Eq traits and, for every
+//   #define HashMapKey K / #define HashMapValue V + include
+// an open-addressing HashMap(K, V) with keys and values stored inline.
+// Hashing and comparison are call(Hash.hash, ...) / call(Eq.eq, ...),
+// resolved at compile time.  Probing checks 16 control bytes per step (SSE2
+// when available), and Eq only runs on slots whose 7-bit hash tag matches.
+
+// ---- types + impls -----------------------------------------------------------
+typedef struct { int x, y; } Point;
+
+#define For Point
+#define Impl Hash
+  uint64_t constdef(hash) { return trait_hash_mix((uint64_t)(uint32_t)self->x << 32 | (uint32_t)self->y); }
+#include "../trait.h"
+
+#define For Point
+#define Impl Eq
+  int constdef(eq, const Point *o) { return self->x == o->x && self->y == o->y; }
+#include "../trait.h"
+
+// A deliberately bad hash: every key collides, so lookups rely on Eq.
+typedef struct { int id; } Clash;
+
+#define For Clash
+#define Impl Hash
+  uint64_t constdef(hash) { (void)self; return 42; }
+#include "../trait.h"
+
+#define For Clash
+#define Impl Eq
+  int constdef(eq, const Clash *o) { return self->id == o->id; }
+#include "../trait.h"
+
+#define HashMapKey int
+#define HashMapValue int
+#include "../traits/hash.h"
+
+#define HashMapKey trait_str
+#define HashMapValue int
+#include "../traits/hash.h"
+
+#define HashMapKey Point
+#define HashMapValue trait_str
+#include "../traits/hash.h"
+
+#define HashMapKey Clash
+#define HashMapValue int
+#include "../traits/hash.h"
+
+
+// ---- main --------------------------------------------------------------------
+static int tests = 0, passed = 0;
+#define TEST(cond, msg) do { tests++; if (cond) { passed++; } \
+  else { printf("  FAIL: %s\n", msg); } } while(0)
+
+static unsigned rng = 777;
+static int next(int mod) { rng = rng * 1103515245u + 12345u; return (int)((rng >> 8) % (unsigned)mod); }
+
+#define RANGE 4096
+static int model[RANGE];   // 0: absent, else value
+
+int main(void) {
+  printf("=== int -> int against a reference array (SIMD %d) ===\n", TRAIT_HASH_SIMD);
+  HashMap(int, int) m = {0};
+  TEST(HashMap_int_int_get(&m, 1) == NULL && !HashMap_int_int_remove(&m, 1), "zeroed map is empty");
+  int ok = 1;
+  size_t live = 0;
+  for (int step = 0; step < 200000; step++) {
+    int k = next(RANGE), op = next(3);
+    if (op < 2) {
+      int v = next(1000) + 1;
+      live += !model[k];
+      model[k] = v;
+      ok &= *HashMap_int_int_put(&m, k, v) == v;
+    } else {
+      ok &= HashMap_int_int_remove(&m, k) == (model[k] != 0);
+      live -= model[k] != 0;
+      model[k] = 0;
+    }
+  }
+  for (int k = 0; k < RANGE; k++) {
+    int *v = HashMap_int_int_get(&m, k);
+    ok &= model[k] ? v && *v == model[k] : v == NULL;
+  }
+  TEST(ok, "200k random puts/removes agree with the model");
+  TEST(m.len == live, "length tracked");
+  TEST(m.cap <= 4 * RANGE, "tombstone churn does not grow the table without bound");
+  size_t seen = 0, it = 0;
+  for (HashMap_int_int_entry *e; (e = HashMap_int_int_next(&m, &it));)
+    seen += model[e->key] == e->val;
+  TEST(seen == live, "iteration visits each entry once");
+  HashMap_int_int_clear(&m);
+  TEST(m.len == 0 && HashMap_int_int_get(&m, 7) == NULL && m.cap > 0, "clear keeps capacity");
+  HashMap_int_int_free(&m);
+
+  printf("\n=== word count (trait_str keys, compared by content) ===\n");
+  static const char text[] = "the quick brown fox jumps over the lazy dog the end";
+  char buf[sizeof text];
+  memcpy(buf, text, sizeof text);
+  HashMap(trait_str, int) wc = {0};
+  for (char *w = strtok(buf, " "); w; w = strtok(NULL, " ")) {
+    int *n = HashMap_trait_str_int_get(&wc, w);
+    if (n) ++*n; else HashMap_trait_str_int_put(&wc, w, 1);
+  }
+  char key[] = "the";                          // different pointer, same content
+  TEST(*HashMap_trait_str_int_get(&wc, key) == 3, "\"the\" counted three times");
+  TEST(wc.len == 9, "nine distinct words");
+  HashMap_trait_str_int_free(&wc);
+
+  printf("\n=== struct keys ===\n");
+  HashMap(Point, trait_str) pm = {0};
+  TEST(HashMap_Point_trait_str_reserve(&pm, 1000) && pm.cap >= 1024, "reserve");
+  size_t cap = pm.cap;
+  for (int i = 0; i < 1000; i++) HashMap_Point_trait_str_put(&pm, (Point){i, -i}, i % 2 ? "odd" : "even");
+  TEST(pm.cap == cap, "no rehash after reserve");
+  const char **s = HashMap_Point_trait_str_get(&pm, (Point){7, -7});
+  TEST(s && strcmp(*s, "odd") == 0 && !HashMap_Point_trait_str_get(&pm, (Point){7, 7}), "lookup by value");
+  HashMap_Point_trait_str_free(&pm);
+
+  printf("\n=== all keys collide ===\n");
+  HashMap(Clash, int) cm = {0};
+  for (int i = 0; i < 100; i++) HashMap_Clash_int_put(&cm, (Clash){i}, i * i);
+  ok = cm.len == 100;
+  for (int i = 0; i < 100; i += 2) ok &= HashMap_Clash_int_remove(&cm, (Clash){i});
+  for (int i = 0; i < 100; i++) {
+    int *v = HashMap_Clash_int_get(&cm, (Clash){i});
+    ok &= i % 2 ? v && *v == i * i : v == NULL;
+  }
+  TEST(ok && cm.len == 50, "probing across groups and tombstones");
+  HashMap_Clash_int_free(&cm);
+
+  printf("\n=== Results: %d/%d tests passed ===\n", passed, tests);
+  return tests == passed ? 0 : 1;
+}
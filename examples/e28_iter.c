@@ -0,0 +1,128 @@
+// clang-format off
+#include "../traits/iter.h"
+#include <stdio.h>
+
+// traits/iter.h: a static Iterator trait (int next(Self *, Self_Item *)) and
+// reinclude generators for Slice, Map, Filter, Take, Zip and Chain.  Every
+// adapter is a concrete struct holding the iterator it wraps by value, and
+// every next() is a statically dispatched call(Iterator.next, ...), so a
+// whole pipeline inlines into one loop: no callbacks, no heap, no vtables.
+
+// ---- data --------------------------------------------------------------------
+typedef struct { int status; long micros; } Record;
+
+static int is_error(const Record *r) { return r->status >= 500; }
+static double millis(const Record *r) { return r->micros / 1000.0; }
+static int is_even(const long *x) { return *x % 2 == 0; }
+static long square(const long *x) { return *x * *x; }
+
+
+// ---- a hand-written iterator type --------------------------------------------
+// Counts down from n to 1.  Its item type is the typedef Countdown_Item.
+typedef struct { int n; } Countdown;
+typedef int Countdown_Item;
+
+#define For Countdown
+#define Impl Iterator
+  int def(next, Countdown_Item *out) { if (self->n <= 0) return 0; *out = self->n--; return 1; }
+#include "../trait.h"
+
+
+// ---- pipelines ---------------------------------------------------------------
+#define IterSlice Records
+#define IterItem Record
+#include "../traits/iter.h"
+
+#define IterFilter Errors
+#define IterFrom Records
+#define IterFn is_error
+#include "../traits/iter.h"
+
+#define IterMap ErrorMillis
+#define IterFrom Errors
+#define IterFn millis
+#define IterTo double
+#include "../traits/iter.h"
+
+#define IterTake FirstErrors
+#define IterFrom ErrorMillis
+#include "../traits/iter.h"
+
+#define IterFilter Evens
+#define IterFrom Range
+#define IterFn is_even
+#include "../traits/iter.h"
+
+#define IterMap EvenSquares
+#define IterFrom Evens
+#define IterFn square
+#define IterTo long
+#include "../traits/iter.h"
+
+#define IterSlice Ints
+#define IterItem int
+#include "../traits/iter.h"
+
+#define IterZip Numbered
+#define IterFrom Range
+#define IterWith Ints
+#include "../traits/iter.h"
+
+#define IterChain Both
+#define IterFrom Ints
+#define IterWith Countdown
+#include "../traits/iter.h"
+
+
+// ---- main --------------------------------------------------------------------
+static int tests = 0, passed = 0;
+#define TEST(cond, msg) do { tests++; if (cond) { passed++; } \
+  else { printf("  FAIL: %s\n", msg); } } while(0)
+
+int main(void) {
+  static const Record log[] = {
+    {200, 1200}, {503, 45000}, {200, 900}, {500, 120000}, {404, 300},
+    {502, 8000}, {200, 700}, {500, 2500},
+  };
+  size_t n = sizeof log / sizeof *log;
+
+  printf("=== filter -> map -> take over log records ===\n");
+  FirstErrors it = FirstErrors_new(ErrorMillis_new(Errors_new(Records_new(log, n))), 3);
+  double total = 0;
+  int count = 0;
+  for (double ms; call(Iterator.next, &it, &ms);) {
+    printf("  %.1f ms\n", ms);
+    total += ms;
+    count++;
+  }
+  double expect = 0;                                     // the same loop by hand
+  for (size_t i = 0, k = 0; i < n && k < 3; i++)
+    if (log[i].status >= 500) { expect += log[i].micros / 1000.0; k++; }
+  TEST(count == 3 && total == expect, "pipeline matches the hand-written loop");
+  TEST(!call(Iterator.next, &it, &total), "exhausted iterator stays exhausted");
+  TEST(sizeof(FirstErrors) == sizeof(Records) + sizeof(size_t),
+       "adapters add no pointers: one nested struct");
+
+  printf("\n=== Range, filter, map ===\n");
+  EvenSquares sq = EvenSquares_new(Evens_new(Range_new(0, 10)));
+  long sum = 0;
+  for (long v; call(Iterator.next, &sq, &v);) sum += v;
+  TEST(sum == 0 + 4 + 16 + 36 + 64, "sum of even squares below 10");
+
+  printf("\n=== zip and chain ===\n");
+  static const int xs[] = { 10, 20, 30 };
+  Numbered z = Numbered_new(Range_new(1, 100), Ints_new(xs, 3));
+  int zipped = 0, ok = 1;
+  for (Numbered_Item p; call(Iterator.next, &z, &p); zipped++)
+    ok &= p.b == 10 * p.a;
+  TEST(ok && zipped == 3, "zip stops at the shorter side");
+  Countdown cd = { 3 };
+  Both b = Both_new(Ints_new(xs, 3), cd);
+  int seq[6], k = 0;
+  for (int v; k < 6 && call(Iterator.next, &b, &v);) seq[k++] = v;
+  TEST(k == 6 && seq[0] == 10 && seq[2] == 30 && seq[3] == 3 && seq[5] == 1,
+       "chain: slice, then hand-written countdown");
+
+  printf("\n=== Results: %d/%d tests passed ===\n", passed, tests);
+  return tests == passed ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+// clang-format off
+#include "../traits/alloc.h"
+#include <stdio.h>
+
+// traits/alloc.h: a static Allocator trait (alloc, realloc, free, reset) with
+// SystemAlloc, ArenaAlloc and PoolAlloc.  The allocator is chosen by type,
+// so call(Allocator.alloc, &arena, n) is a direct call that inlines to a
+// bounds check and a pointer bump.  Generated containers take the allocator
+// type as a parameter; here a HashMap lives in a per-request arena.
+
+// ---- a subsystem parametrised by its allocator type --------------------------
+typedef struct Node { struct Node *next; int v; } Node;
+
+#define LIST_BUILD(A)                                                          \
+  static Node *build_##A(A *a, int n) {                                        \
+    Node *head = NULL;                                                         \
+    for (int i = 0; i < n; i++) {                                              \
+      Node *x = (Node *)call(Allocator.alloc, a, sizeof *x);                   \
+      x->v = i; x->next = head; head = x;                                      \
+    }                                                                          \
+    return head;                                                               \
+  }
+LIST_BUILD(ArenaAlloc)
+LIST_BUILD(PoolAlloc)
+
+static int sum(const Node *n) { int s = 0; for (; n; n = n->next) s += n->v; return s; }
+
+#include "../traits/hash.h"
+
+#define HashMapKey int
+#define HashMapValue int
+#define HashMapAlloc ArenaAlloc
+#include "../traits/hash.h"
+
+
+// ---- main --------------------------------------------------------------------
+static int tests = 0, passed = 0;
+#define TEST(cond, msg) do { tests++; if (cond) { passed++; } \
+  else { printf("  FAIL: %s\n", msg); } } while(0)
+
+int main(void) {
+  printf("=== arena ===\n");
+  ArenaAlloc arena = {0};
+  char *a = (char *)call(Allocator.alloc, &arena, 10);
+  char *b = (char *)call(Allocator.alloc, &arena, 1);
+  TEST(a && b == a + TRAIT_ALLOC_ALIGN, "bump, aligned to TRAIT_ALLOC_ALIGN");
+  TEST(call(Allocator.realloc, &arena, b, 1, 1000) == b, "latest allocation grows in place");
+  call(Allocator.free, &arena, b, 1000);
+  TEST(call(Allocator.alloc, &arena, 8) == b, "freeing the latest allocation rewinds");
+  TEST(sum(build_ArenaAlloc(&arena, 10000)) == 10000 * 9999 / 2, "10k nodes across chunks");
+  TEST(arena.chunks && arena.chunks->prev, "grew into several chunks");
+  size_t biggest = arena.chunks->size;
+  call(Allocator.reset, &arena);
+  TEST(!arena.chunks->prev && arena.chunks->size == biggest &&
+       call(Allocator.alloc, &arena, 1) == (void *)arena.base,
+       "reset keeps only the largest chunk and starts over");
+  ArenaAlloc_release(&arena);
+
+  static union { char bytes[256]; long double align; } stack;
+  ArenaAlloc on = ArenaAlloc_on(stack.bytes, sizeof stack.bytes);
+  TEST(call(Allocator.alloc, &on, 100) == stack.bytes && !on.chunks, "caller buffer first");
+  TEST(call(Allocator.alloc, &on, 200) != NULL && on.chunks, "then the heap");
+  ArenaAlloc_release(&on);
+
+  // Sizes whose rounding or chunk size would wrap fail instead of
+  // returning a block smaller than asked for.
+  void *last = call(Allocator.alloc, &arena, 32);
+  TEST(call(Allocator.alloc, &arena, SIZE_MAX) == NULL &&
+       call(Allocator.alloc, &arena, SIZE_MAX / 2 + 2) == NULL, "huge requests fail");
+  TEST(last && call(Allocator.realloc, &arena, last, 32, SIZE_MAX) == NULL,
+       "huge realloc fails instead of growing in place");
+  ArenaAlloc_release(&arena);
+
+  printf("\n=== pool ===\n");
+  PoolAlloc pool = PoolAlloc_new(sizeof(Node));
+  TEST(sum(build_PoolAlloc(&pool, 1000)) == 1000 * 999 / 2, "1000 nodes from slabs");
+  void *x = call(Allocator.alloc, &pool, sizeof(Node));
+  call(Allocator.free, &pool, x, sizeof(Node));
+  TEST(call(Allocator.alloc, &pool, sizeof(Node)) == x, "free list reuses the block");
+  TEST(call(Allocator.alloc, &pool, 4096) == NULL, "requests above the block size fail");
+  PoolAlloc_release(&pool);
+  PoolAlloc huge = PoolAlloc_new(SIZE_MAX / 2);
+  TEST(call(Allocator.alloc, &huge, 1) == NULL, "a slab too large to size fails");
+  PoolAlloc_release(&huge);
+
+  printf("\n=== system ===\n");
+  SystemAlloc *sys = NULL;                       // stateless
+  int *v = (int *)call(Allocator.alloc, sys, 4 * sizeof(int));
+  v[3] = 7;
+  v = (int *)call(Allocator.realloc, sys, v, 4 * sizeof(int), 1000 * sizeof(int));
+  TEST(v && v[3] == 7, "realloc keeps contents");
+  call(Allocator.free, sys, v, 1000 * sizeof(int));
+
+  printf("\n=== HashMap in a per-request arena ===\n");
+  ArenaAlloc req = {0};
+  int ok = 1;
+  for (int round = 0; round < 3; round++) {
+    HashMap(int, int) m = {0};
+    m.alloc = &req;
+    for (int i = 0; i < 5000; i++) HashMap_int_int_put(&m, i, i * 2);
+    for (int i = 0; i < 5000; i++) ok &= *HashMap_int_int_get(&m, i) == i * 2;
+    call(Allocator.reset, &req);                 // drop the whole map at once
+  }
+  TEST(ok && !req.chunks->prev, "three requests, one chunk reused");
+  ArenaAlloc_release(&req);
+
+  printf("\n=== Results: %d/%d tests passed ===\n", passed, tests);
+  return tests == passed ? 0 : 1;
+}
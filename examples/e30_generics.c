@@ -0,0 +1,95 @@
+// clang-format off
+#include "../trait.h"
+#include <stddef.h>
+#include <stdio.h>
+
+// Generic algorithms stamped per impl.  <Trait>Generics(X) lists them, and
+// nameGeneric(T) is the body, written once with T for the implementing type.
+// Every later impl block of the trait stamps name_<For> right after its own
+// SD slots, so the body's call(Trait.method, ...) resolves statically, and
+// call_generic(name, arr, ...) picks the copy by the element type.
+
+// ---- trait -------------------------------------------------------------------
+#define Dynamic
+#define AnimalSignature(Self)              \
+  required(Self, int, get_snacks)          \
+  required(Self, void, feed, int)
+#define Trait Animal
+#include "../trait.h"
+
+// ---- generics: declared before the impls they are stamped for ----------------
+#define AnimalGenerics(X) X(feed_all) X(total_snacks) X(feed_hungry)
+
+#define feed_allGeneric(T)                                                     \
+  static void glue(feed_all_, T)(T *arr, size_t n) {                           \
+    for (size_t i = 0; i < n; i++) call(Animal.feed, &arr[i], 1);              \
+  }
+#define total_snacksGeneric(T)                                                 \
+  static int glue(total_snacks_, T)(const T *arr, size_t n) {                  \
+    int s = 0;                                                                 \
+    for (size_t i = 0; i < n; i++) s += call(Animal.get_snacks, (T *)&arr[i]); \
+    return s;                                                                  \
+  }
+// A generic may use the generics listed before it.
+#define feed_hungryGeneric(T)                                                  \
+  static int glue(feed_hungry_, T)(T *arr, size_t n, int below) {              \
+    int before = call_generic(total_snacks, arr, n);                           \
+    for (size_t i = 0; i < n; i++)                                             \
+      if (call(Animal.get_snacks, &arr[i]) < below) call(Animal.feed, &arr[i], 1); \
+    return call_generic(total_snacks, arr, n) - before;                        \
+  }
+
+// ---- types + impls -----------------------------------------------------------
+typedef struct { int snacks; } Dog;
+typedef struct { int fish; } Cat;
+
+#define For Dog
+#define Impl Animal
+  int def(get_snacks) { return self->snacks; }
+  void def(feed, int n) { self->snacks += n; }
+#include "../trait.h"
+
+#define For Cat
+#define Impl Animal
+  int def(get_snacks) { return self->fish; }
+  void def(feed, int n) { self->fish += 2 * n; }
+#include "../trait.h"
+
+// The same loop through trait objects, for comparison.
+static void feed_all_dyn(DynAnimal *arr, size_t n) {
+  for (size_t i = 0; i < n; i++) call(Animal.feed, &arr[i], 1);
+}
+
+
+// ---- main --------------------------------------------------------------------
+static int tests = 0, passed = 0;
+#define TEST(cond, msg) do { tests++; if (cond) { passed++; } \
+  else { printf("  FAIL: %s\n", msg); } } while(0)
+
+int main(void) {
+  printf("=== stamped copies ===\n");
+  Dog dogs[] = { {1}, {2}, {3} };
+  Cat cats[] = { {0}, {5} };
+  feed_all_Dog(dogs, 3);
+  feed_all_Cat(cats, 2);
+  TEST(dogs[0].snacks == 2 && dogs[2].snacks == 4, "feed_all_Dog");
+  TEST(cats[0].fish == 2 && cats[1].fish == 7, "feed_all_Cat");
+  TEST(total_snacks_Dog(dogs, 3) == 9 && total_snacks_Cat(cats, 2) == 9, "total_snacks_<T>");
+
+  printf("\n=== call_generic picks by element type ===\n");
+  call_generic(feed_all, dogs, 3);
+  call_generic(feed_all, cats, 2);
+  TEST(call_generic(total_snacks, dogs, 3) == 12, "dogs fed again");
+  TEST(call_generic(total_snacks, cats, 2) == 13, "cats fed again");
+  TEST(call_generic(feed_hungry, cats, 2, 5) == 2, "generic calling a generic");
+
+  printf("\n=== same result as the DynAnimal loop ===\n");
+  Dog more[] = { {10}, {20} };
+  DynAnimal objs[] = { dyn(Animal, &more[0]), dyn(Animal, &more[1]) };
+  feed_all_dyn(objs, 2);
+  call_generic(feed_all, more, 2);
+  TEST(more[0].snacks == 12 && more[1].snacks == 22, "vtable loop and stamped loop agree");
+
+  printf("\n=== Results: %d/%d tests passed ===\n", passed, tests);
+  return tests == passed ? 0 : 1;
+}
@@ -0,0 +1,106 @@
+// clang-format off
+#include "../trait.h"
+#include <assert.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+// Compile-time specialization.  implements(Type, Trait) is an integer
+// constant expression (1 once an impl block of Trait for Type has been seen),
+// and if_impl(Trait, ptr, then, else) picks one of two expressions by the
+// type of *ptr.  Generic code takes a fast path for types that have one;
+// both expressions must compile for every type it is used with.
+
+// ---- traits ------------------------------------------------------------------
+typedef struct { unsigned char *p; size_t len; int fast, slow; } Out;
+
+// Wire: write one value, field by field.
+#define WireSignature(Self)                      \
+  required(immutable(Self), void, write, Out *)
+#define Trait Wire
+#include "../trait.h"
+
+// Pod: the in-memory bytes are the wire format.
+#define PodSignature(Self)                       \
+  required(immutable(Self), size_t, pod_size)
+#define Trait Pod
+#include "../trait.h"
+
+static void put(Out *o, const void *src, size_t n) { memcpy(o->p + o->len, src, n); o->len += n; }
+
+// ---- generic writer: memcpy when the element type is Pod ---------------------
+#define WireGenerics(X) X(write_all)
+#define write_allGeneric(T)                                                    \
+  static void glue(write_all_, T)(const T *arr, size_t n, Out *o) {            \
+    if (implements(T, Pod)) {               /* a constant: one side is dead */ \
+      put(o, arr, n * sizeof *arr);                                            \
+      o->fast++;                                                               \
+      return;                                                                  \
+    }                                                                          \
+    for (size_t i = 0; i < n; i++) call(Wire.write, &arr[i], o);               \
+    o->slow++;                                                                 \
+  }
+
+// ---- types + impls -----------------------------------------------------------
+typedef struct { int x, y; } Point;                    // plain data
+typedef struct { const char *s; } Name;                // holds a pointer
+
+#define For Point
+#define Impl Pod
+  size_t constdef(pod_size) { (void)self; return sizeof(Point); }
+#include "../trait.h"
+
+#define For Point
+#define Impl Wire
+  void constdef(write, Out *o) { put(o, &self->x, sizeof self->x); put(o, &self->y, sizeof self->y); }
+#include "../trait.h"
+
+#define For Name
+#define Impl Wire
+  void constdef(write, Out *o) { put(o, self->s, strlen(self->s) + 1); }
+#include "../trait.h"
+
+// Resolved by the compiler: usable in static_assert, enums and array sizes.
+static_assert(implements(Point, Pod) && !implements(Name, Pod), "Pod impls");
+static_assert(implements(Name, Wire), "Name is Wire");
+enum { INT_IS_POD = implements(int, Pod) };
+
+// The expression if_impl did not select is never evaluated.
+static int evaluated = 0;
+static int touch(int v) { evaluated++; return v; }
+
+
+// ---- main --------------------------------------------------------------------
+static int tests = 0, passed = 0;
+#define TEST(cond, msg) do { tests++; if (cond) { passed++; } \
+  else { printf("  FAIL: %s\n", msg); } } while(0)
+
+int main(void) {
+  printf("=== implements ===\n");
+  TEST(implements(Point, Wire) == 1 && implements(Name, Pod) == 0, "1 or 0");
+  TEST(INT_IS_POD == 0, "a type with no impls");
+  char arr[1 + implements(Point, Pod)];
+  TEST(sizeof arr == 2, "usable as an array size");
+
+  printf("\n=== if_impl ===\n");
+  Point pt = { 1, 2 };
+  const Name nm = { "n" };
+  TEST(if_impl(Pod, &pt, touch(10), touch(20)) == 10, "Point takes the then branch");
+  TEST(if_impl(Pod, &nm, touch(10), touch(20)) == 20, "const Name takes the else branch");
+  TEST(evaluated == 2, "one side evaluated per use");
+
+  printf("\n=== generic writer ===\n");
+  unsigned char buf[256];
+  Out o = { buf, 0, 0, 0 };
+  Point pts[3] = { {1, 2}, {3, 4}, {5, 6} };
+  Name names[2] = { {"ab"}, {"c"} };
+  call_generic(write_all, pts, 3, &o);
+  size_t after_pts = o.len;
+  call_generic(write_all, names, 2, &o);
+  TEST(o.fast == 1 && o.slow == 1, "Point by memcpy, Name field by field");
+  TEST(after_pts == sizeof pts && memcmp(buf, pts, sizeof pts) == 0, "bulk bytes");
+  TEST(o.len == after_pts + 5 && strcmp((char *)buf + after_pts + 3, "c") == 0, "per-field bytes");
+
+  printf("\n=== Results: %d/%d tests passed ===\n", passed, tests);
+  return tests == passed ? 0 : 1;
+}
@@ -0,0 +1,88 @@
+// clang-format off
+#include "../traits/clone.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// traits/clone.h: Clone (construct a copy in dst) and the marker Copy.
+// clone_slice(T, dst, src, n) is memcpy for Copy types and a loop of direct
+// Clone calls otherwise, picked at compile time.  Over trait objects,
+// clone_slice(DynClone, ...) makes one vtable call per run of objects of
+// the same type; that type's clone_run then loops with direct calls.
+
+// ---- types -------------------------------------------------------------------
+typedef struct { int id, len; } Header;                 // plain data
+#define CopyType Header
+#include "../traits/clone.h"
+
+typedef struct { char *text; } Body;                    // owns its text
+
+#define For Body
+#define Impl Clone
+  void constdef(clone, void *dst) {
+    size_t n = strlen(self->text) + 1;
+    Body *b = (Body *)dst;
+    b->text = (char *)malloc(n);
+    memcpy(b->text, self->text, n);
+  }
+#include "../trait.h"
+
+// A type that counts how often the vtable's clone_run is entered.
+typedef struct { int v; } Tracked;
+static int tracked_runs = 0;
+
+#define For Tracked
+#define Impl Clone
+  void constdef(clone, void *dst) { ((Tracked *)dst)->v = self->v; }
+#define Override_Tracked_Clone_clone_run 1
+  void constdef(clone_run, void *const *dst, const void *const *src, size_t n) {
+    (void)self;
+    tracked_runs++;
+    for (size_t i = 0; i < n; i++) Tracked_Clone_clone((const Tracked *)src[i], dst[i]);
+  }
+#include "../trait.h"
+
+
+// ---- main --------------------------------------------------------------------
+static int tests = 0, passed = 0;
+#define TEST(cond, msg) do { tests++; if (cond) { passed++; } \
+  else { printf("  FAIL: %s\n", msg); } } while(0)
+
+int main(void) {
+  printf("=== static slices ===\n");
+  TEST(implements(Header, Copy) && !implements(Body, Copy) && implements(Body, Clone), "Copy is a marker");
+  Header hs[3] = { {1, 10}, {2, 20}, {3, 30} }, hd[3];
+  clone_slice(Header, hd, hs, 3);
+  TEST(memcmp(hd, hs, sizeof hs) == 0, "Header: bytes copied");
+  Body bs[2] = { {"GET /a"}, {"GET /b"} }, bd[2];
+  clone_slice(Body, bd, bs, 2);
+  TEST(bd[0].text != bs[0].text && strcmp(bd[1].text, "GET /b") == 0, "Body: deep copies");
+  double xs[2] = { 1.5, 2.5 }, ys[2];
+  clone_slice(double, ys, xs, 2);
+  TEST(ys[1] == 2.5, "builtins are Copy");
+
+  printf("\n=== trait objects, batched by type ===\n");
+  // A request graph: 3 Tracked, 1 Header, 2 Tracked.
+  Tracked t[5] = { {1}, {2}, {3}, {4}, {5} };
+  Header h = { 9, 90 };
+  DynClone objs[6] = { dyn(Clone, &t[0]), dyn(Clone, &t[1]), dyn(Clone, &t[2]),
+                       dyn(Clone, &h), dyn(Clone, &t[3]), dyn(Clone, &t[4]) };
+  Tracked tc[5];
+  Header hc;
+  void *dst[6] = { &tc[0], &tc[1], &tc[2], &hc, &tc[3], &tc[4] };
+  clone_slice(DynClone, dst, objs, 6);
+  TEST(tc[0].v == 1 && tc[2].v == 3 && tc[4].v == 5 && hc.id == 9, "every object cloned");
+  TEST(tracked_runs == 2, "one clone_run per run of Tracked");
+
+  static Tracked many[150], copies[150];
+  static DynClone mo[150];
+  static void *md[150];
+  for (int i = 0; i < 150; i++) { many[i].v = i; mo[i] = dyn(Clone, &many[i]); md[i] = &copies[i]; }
+  tracked_runs = 0;
+  clone_slice(DynClone, md, mo, 150);
+  TEST(tracked_runs == (150 + TRAIT_CLONE_RUN - 1) / TRAIT_CLONE_RUN && copies[149].v == 149,
+       "long runs split at TRAIT_CLONE_RUN");
+
+  for (int i = 0; i < 2; i++) free(bd[i].text);
+  printf("\n=== Results: %d/%d tests passed ===\n", passed, tests);
+  return tests == passed ? 0 : 1;
+}
@@ -0,0 +1,116 @@
+// clang-format off
+#include "../traits/codec.h"
+#include <stdio.h>
+
+// traits/codec.h: Encode / Decode.  CodecStruct + CodecFields emit both impls
+// for a struct, one call(Encode.encode, &self->field, b) per field; each
+// resolves to the field type's impl at compile time.  encode_msg reserves
+// size_hint bytes once and then writes without reallocating.
+
+// ---- message types -----------------------------------------------------------
+typedef struct { unsigned id; double px; trait_str sym; } Quote;
+#define CodecStruct Quote
+#define CodecFields(F) F(id) F(px) F(sym)
+#include "../traits/codec.h"
+
+typedef struct { Quote q; long qty; trait_uchar side; float fee; } Trade;
+#define CodecStruct Trade                                // nests Quote's impls
+#define CodecFields(F) F(q) F(qty) F(side) F(fee)
+#include "../traits/codec.h"
+
+// A hand-written impl: a fixed-width word, bypassing the varint.
+typedef struct { uint32_t bits; } Flags;
+
+#define For Flags
+#define Impl Encode
+  void constdef(encode, EncodeBuf *b) { trait_encode_le(b, self->bits, 4); }
+  size_t constdef(size_hint) { (void)self; return 4; }
+#include "../trait.h"
+
+#define For Flags
+#define Impl Decode
+  int def(decode, DecodeBuf *in) {
+    uint64_t w;
+    if (!trait_decode_le(in, &w, 4)) return 0;
+    self->bits = (uint32_t)w;
+    return 1;
+  }
+#include "../trait.h"
+
+
+// ---- main --------------------------------------------------------------------
+static int tests = 0, passed = 0;
+#define TEST(cond, msg) do { tests++; if (cond) { passed++; } \
+  else { printf("  FAIL: %s\n", msg); } } while(0)
+
+int main(void) {
+  printf("=== builtins ===\n");
+  EncodeBuf b = {0};
+  int neg = -1;
+  unsigned big = 300;
+  call(Encode.encode, &neg, &b);
+  call(Encode.encode, &big, &b);
+  TEST(b.len == 3 && b.data[0] == 1 && b.data[1] == 0xac && b.data[2] == 0x02, "zigzag and LEB128 varints");
+  double d = 0.5;
+  call(Encode.encode, &d, &b);
+  TEST(b.len == 11 && b.data[10] == 0x3f && b.data[9] == 0xe0, "double little-endian");
+  DecodeBuf in = DecodeBuf_on(b.data, b.len);
+  int n2 = 0; unsigned u2 = 0; double d2 = 0;
+  TEST(call(Decode.decode, &n2, &in) && call(Decode.decode, &u2, &in) && call(Decode.decode, &d2, &in)
+       && n2 == -1 && u2 == 300 && d2 == 0.5 && in.p == in.end, "round trip");
+
+  printf("\n=== derived structs ===\n");
+  Trade t = { { 42, 101.25, "ACME" }, -7, 'B', 0.125f };
+  b.len = 0;
+  EncodeBuf_reserve(&b, call(Encode.size_hint, &t));
+  uint8_t *reserved = b.data;
+  call(Encode.encode, &t, &b);
+  TEST(b.data == reserved && b.len <= call(Encode.size_hint, &t), "one reservation per message");
+  Trade r = {0};
+  in = DecodeBuf_on(b.data, b.len);
+  int ok = call(Decode.decode, &r, &in);
+  TEST(ok && in.p == in.end, "decoded whole message");
+  TEST(ok && r.q.id == 42 && r.q.px == 101.25 && strcmp(r.q.sym, "ACME") == 0 && r.qty == -7
+       && r.side == 'B' && r.fee == 0.125f, "fields round trip");
+  TEST(ok && r.q.sym >= (const char *)b.data && r.q.sym < (const char *)b.data + b.len, "strings are zero-copy");
+
+  printf("\n=== malformed input ===\n");
+  size_t whole = b.len;
+  int all_short_fail = 1;
+  for (size_t cut = 0; cut < whole; cut++) {
+    in = DecodeBuf_on(b.data, cut);
+    all_short_fail &= !call(Decode.decode, &r, &in);
+  }
+  TEST(all_short_fail, "every truncation is rejected");
+  uint8_t bad[] = { 3, 'a', 'b', 'c', 'd' };                     // no NUL after "abc"
+  trait_str s;
+  in = DecodeBuf_on(bad, sizeof bad);
+  TEST(!call(Decode.decode, &s, &in), "unterminated string rejected");
+  uint8_t v11[] = { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x01 };
+  uint8_t v10_max[] = { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01 };
+  uint8_t v10_over[] = { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x03 };
+  uint8_t overlong[] = { 0x81, 0x00 };
+  uint64_t w = 0;
+  DecodeBuf i11 = DecodeBuf_on(v11, sizeof v11), imax = DecodeBuf_on(v10_max, sizeof v10_max);
+  DecodeBuf iover = DecodeBuf_on(v10_over, sizeof v10_over), ilong = DecodeBuf_on(overlong, sizeof overlong);
+  TEST(!trait_decode_varint(&i11, &w) && !trait_decode_varint(&iover, &w),
+       "11-byte and overflowing 10-byte varints rejected");
+  TEST(trait_decode_varint(&imax, &w) && w == UINT64_MAX, "UINT64_MAX still decodes");
+  TEST(!trait_decode_varint(&ilong, &w), "overlong varint rejected");
+
+  printf("\n=== hand-written impl + encode_msg ===\n");
+  Flags f = { 0xdeadbeef }, f2 = { 0 };
+  b.len = 0;
+  encode_msg(&f, &b);
+  in = DecodeBuf_on(b.data, b.len);
+  TEST(b.len == 4 && b.data[0] == 0xef && call(Decode.decode, &f2, &in) && f2.bits == 0xdeadbeef, "fixed-width word");
+  Flags fs[2] = { { 1 }, { 2 } };
+  Flags *next = fs;
+  b.len = 0;
+  encode_msg(next++, &b);
+  TEST(next == fs + 1 && b.len == 4 && b.data[0] == 1, "encode_msg evaluates its arguments once");
+
+  EncodeBuf_free(&b);
+  printf("\n=== Results: %d/%d tests passed ===\n", passed, tests);
+  return tests == passed ? 0 : 1;
+}
@@ -0,0 +1,147 @@
+// clang-format off
+#include "../traits/fmt.h"
+#include <limits.h>
+#include <stdio.h>
+
+// traits/fmt.h: Format writes text into an arena-backed FmtBuf instead of
+// calling printf.  An impl formats its fields with call(Format.fmt, ...),
+// which resolves to each field type's impl at compile time, so a nested
+// record is a tree of direct calls.  The text goes out with one fwrite.
+
+// ---- types + impls -----------------------------------------------------------
+typedef struct { int x, y; } Point;
+typedef struct { long seq; trait_str level; Point at; double ms; } Record;
+
+#define For Point
+#define Impl Format
+  void constdef(fmt, FmtBuf *b) {
+    fmt_lit(b, "(");
+    call(Format.fmt, &self->x, b);
+    fmt_lit(b, ", ");
+    call(Format.fmt, &self->y, b);
+    fmt_lit(b, ")");
+  }
+#include "../trait.h"
+
+#define For Record
+#define Impl Format
+  void constdef(fmt, FmtBuf *b) {
+    call(Format.fmt, &self->seq, b);
+    fmt_lit(b, " [");
+    call(Format.fmt, &self->level, b);
+    fmt_lit(b, "] at ");
+    call(Format.fmt, &self->at, b);               // Point's impl, directly
+    fmt_lit(b, " took ");
+    fmt_f64(b, self->ms, 2);
+    fmt_lit(b, "ms\n");
+  }
+#define Override_Record_Format_len_hint 1
+  size_t constdef(len_hint) { return 64 + strlen(self->level); }
+#include "../trait.h"
+
+
+// ---- main --------------------------------------------------------------------
+static int tests = 0, passed = 0;
+#define TEST(cond, msg) do { tests++; if (cond) { passed++; } \
+  else { printf("  FAIL: %s\n", msg); } } while(0)
+
+// b's text equals the snprintf output of a format, for comparison.
+static int same(FmtBuf *b, const char *want) {
+  int ok = b->len == strlen(want) && memcmp(b->data, want, b->len) == 0;
+  FmtBuf_clear(b);
+  return ok;
+}
+
+int main(void) {
+  ArenaAlloc arena = {0};
+  FmtBuf b = FmtBuf_in(&arena);
+  char want[64];
+
+  printf("=== integers ===\n");
+  long ls[] = { 0, 7, -7, 99, 100, -12345, LONG_MAX, LONG_MIN };
+  int ints_ok = 1;
+  for (size_t i = 0; i < sizeof ls / sizeof *ls; i++) {
+    call(Format.fmt, &ls[i], &b);
+    snprintf(want, sizeof want, "%ld", ls[i]);
+    ints_ok &= same(&b, want);
+  }
+  TEST(ints_ok, "long matches %ld, including the extremes");
+  unsigned u = UINT_MAX;
+  call(Format.fmt, &u, &b);
+  TEST(same(&b, "4294967295"), "unsigned");
+
+  printf("\n=== floats ===\n");
+  double ds[] = { 0.0, 3.14159265, -2.5, 0.0000004, 1234567.125, -0.1 };
+  int f_ok = 1;
+  for (size_t i = 0; i < sizeof ds / sizeof *ds; i++) {
+    call(Format.fmt, &ds[i], &b);
+    snprintf(want, sizeof want, "%.6f", ds[i]);
+    f_ok &= same(&b, want);
+  }
+  TEST(f_ok, "double matches %.6f");
+  fmt_f64(&b, 2.5, 0);
+  fmt_char(&b, ' ');
+  fmt_f64(&b, 1.125, 2);
+  fmt_char(&b, ' ');
+  fmt_f64(&b, -0.001, 2);
+  TEST(same(&b, "2 1.12 -0.00"), "ties to even and the sign of zero, like printf");
+  double hard[] = { 23382.634999999998, 32652697032763500.0, 29048126007887404.0, 1e300, 0.1 + 0.2 };
+  unsigned hard_prec[] = { 2, 1, 2, 3, 9 };
+  int hard_ok = 1;
+  for (size_t i = 0; i < sizeof hard / sizeof *hard; i++) {
+    fmt_f64(&b, hard[i], hard_prec[i]);
+    static char big[400];
+    snprintf(big, sizeof big, "%.*f", (int)hard_prec[i], hard[i]);
+    hard_ok &= same(&b, big);
+  }
+  TEST(hard_ok, "near-ties, 2^53 and up, huge values");
+
+  // Random bit patterns (every magnitude) and random decimals, all precisions.
+  uint64_t seed = 0x9e3779b97f4a7c15ull;
+  int mismatches = 0;
+  for (int i = 0; i < 200000; i++) {
+    seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17;
+    double v;
+    if (i & 1) {
+      memcpy(&v, &seed, sizeof v);
+    } else {
+      v = (double)(int64_t)(seed >> 11) / (double)(1ull << (seed & 63));
+    }
+    unsigned prec = (unsigned)(seed >> 40) % 10;
+    static char ref[400];
+    snprintf(ref, sizeof ref, "%.*f", (int)prec, v);
+    fmt_f64(&b, v, prec);
+    mismatches += !same(&b, ref);
+  }
+  TEST(mismatches == 0, "200k random values match printf %.*f");
+
+  printf("\n=== composed records ===\n");
+  Record r = { 42, "warn", { 3, -4 }, 1.125 };
+  format_value(&r, &b);
+  TEST(strcmp(FmtBuf_str(&b), "42 [warn] at (3, -4) took 1.12ms\n") == 0, "nested struct");
+  FmtBuf_clear(&b);
+  Point p = { 1, 2 };
+  TEST(call(Format.len_hint, &p) == 16 && call(Format.len_hint, &r) == 68, "default and overridden len_hint");
+  Point ps[2] = { { 5, 6 }, { 7, 8 } };
+  Point *next = ps;
+  format_value(next++, &b);
+  TEST(next == ps + 1 && strcmp(FmtBuf_str(&b), "(5, 6)") == 0, "format_value evaluates its arguments once");
+  FmtBuf_clear(&b);
+
+  printf("\n=== a batch in one buffer ===\n");
+  char *first = NULL;
+  r.ms = 0.25;
+  for (int i = 0; i < 1000; i++) {
+    r.seq = i;
+    format_value(&r, &b);
+    if (!first) first = b.data;
+  }
+  TEST(b.data == first && !b.failed, "grew in place in the arena");
+  const char last[] = "999 [warn] at (3, -4) took 0.25ms\n";
+  TEST(b.len > 1000 * 30 && memcmp(b.data + b.len - (sizeof last - 1), last, sizeof last - 1) == 0, "last record");
+  fwrite(b.data, 1, (size_t)((char *)memchr(b.data, '\n', b.len) + 1 - b.data), stdout); // one call
+
+  ArenaAlloc_release(&arena);
+  printf("\n=== Results: %d/%d tests passed ===\n", passed, tests);
+  return tests == passed ? 0 : 1;
+}
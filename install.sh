@@ -1 +1,3 @@
 cp ./trait.h ~/.local/include/trait.h
+mkdir -p ~/.local/include/traits
+cp ./traits/*.h ~/.local/include/traits/
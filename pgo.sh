@@ -0,0 +1,91 @@
+#!/usr/bin/env bash
+# Turn a TRAIT_TRACE profile into a header of devirtualization hints.
+#
+# Usage:
+#   ./pgo.sh [--min PCT] BINARY PROFILE > trait_hints.h
+#
+# 1. Build with -DTRAIT_TRACE, call trait_trace_set_rate(N) early and
+#    trait_trace_dump_pgo(f) before exit, run a representative workload.
+# 2. ./pgo.sh ./app profile.txt > trait_hints.h
+# 3. Rebuild with -include trait_hints.h (the hints must precede the trait
+#    definitions).  Each Trait.method whose hottest implementation took at
+#    least PCT% (default 60) of the samples gets
+#      #define Hint_Animal_get_snacks (Dog_Animal_get_snacks)
+#    and its DynSD wrappers call that function directly when the vtable slot
+#    matches, falling back to the indirect call otherwise.
+#
+# BINARY is the executable that wrote PROFILE (not stripped): vtable addresses
+# are mapped to For_Trait_vtable symbols with nm, relative to the profile's
+# anchor so PIE load addresses do not matter.  Only implementations with an
+# external symbol (def()/constdef() bodies) can be hinted; others are listed
+# as comments.
+set -euo pipefail
+
+usage() { echo "usage: $0 [--min PCT] BINARY PROFILE" >&2; exit 2; }
+
+min=60
+if [ "${1:-}" = "--min" ]; then
+  [ $# -ge 2 ] || usage
+  min="$2"
+  shift 2
+fi
+[ $# -eq 2 ] || usage
+bin="$1"
+profile="$2"
+[ -r "$bin" ] || { echo "$0: cannot read $bin" >&2; exit 1; }
+[ -r "$profile" ] || { echo "$0: cannot read $profile" >&2; exit 1; }
+
+echo "// Generated by pgo.sh from $profile ($(basename "$bin")); do not edit."
+echo "// Hottest implementation per dynamic method, at least $min% of its samples."
+echo "#pragma once"
+awk -v min="$min" '
+  function hex(s,    i, c, v) {
+    s = tolower(s); sub(/^0x/, "", s); v = 0
+    for (i = 1; i <= length(s); i++) {
+      c = index("0123456789abcdef", substr(s, i, 1))
+      if (!c) return -1
+      v = v * 16 + c - 1
+    }
+    return v
+  }
+  FILENAME == ARGV[1] {                                  # nm: addr type name
+    if (NF != 3) next
+    if ($3 == "trait_trace_every") anchor_nm = hex($1)
+    if ($3 ~ /_vtable$/) vt[hex($1)] = $3
+    kind[$3] = $2
+    next
+  }
+  $1 == "anchor" { bias = hex($2) - anchor_nm; next }    # profile
+  NF == 5 {
+    trait = $3; m = $4
+    if (match(m, /(\.|->)/)) { mt = substr(m, 1, RSTART - 1); m = substr(m, RSTART + RLENGTH) }
+    else mt = trait
+    sym = vt[hex($5) - bias]
+    suffix = "_" trait "_vtable"
+    if (sym == "" || length(sym) <= length(suffix) ||
+        substr(sym, length(sym) - length(suffix) + 1) != suffix) fn = "?"
+    else fn = substr(sym, 1, length(sym) - length(suffix)) "_" mt "_" m
+    key = mt "_" m
+    total[key] += $1
+    hits[key SUBSEP fn] += $1
+    fns[key] = fns[key] " " fn
+  }
+  END {
+    for (key in total) {
+      best = ""; bestn = 0
+      n = split(fns[key], f, " ")
+      for (i = 1; i <= n; i++)
+        if (hits[key SUBSEP f[i]] > bestn) { best = f[i]; bestn = hits[key SUBSEP f[i]] }
+      pct = int(100 * bestn / total[key])
+      note = sprintf("%d%% of %d samples", pct, total[key])
+      if (best == "?")
+        printf "// %s: vtable not found in binary (%s)\n", key, note
+      else if (pct < min)
+        printf "// %s: %s below threshold (%s)\n", key, best, note
+      else if (kind[best] != "T")
+        printf "// %s: %s has no external symbol (%s)\n", key, best, note
+      else
+        printf "#define Hint_%s (%s) /* %s */\n", key, best, note
+    }
+  }
+' <(nm -n --defined-only "$bin") "$profile" | sort -t' ' -k2,2
@@ -0,0 +1,64 @@
+#!/usr/bin/env bash
+# Rewrite generated dispatch wrapper names (___trait_sd_fn_NNNNNN,
+# ___trait_tt_fn_NNNNNN) into Type.Trait.method, using the trait_symmap table
+# that trait.h emits when compiled with -DTRAIT_SYMMAP.
+#
+# Usage:
+#   ./symmap.sh MAP [FILE...]   rewrite FILEs (or stdin) to stdout
+#   ./symmap.sh --list MAP      print the table: symbol, name, kind
+#
+# MAP is an object file, executable or assembly (.s) file built with
+# -DTRAIT_SYMMAP.  Slot numbers are per TU: an executable linked from several
+# TUs can map one symbol to several names, which are printed joined by '|'.
+#
+#   perf script | ./symmap.sh ./app
+#   ./symmap.sh benchmark_asm/e1_basics_-O0.s benchmark_asm/e1_basics_-O0.s
+set -euo pipefail
+
+usage() { echo "usage: $0 [--list] MAP [FILE...]" >&2; exit 2; }
+
+read_map() {
+  case "$1" in
+    *.s | *.S)
+      sed -nE 's/^[[:space:]]*\.(string|asciz)[[:space:]]+"(___trait_[a-z]+_fn_[0-7]+ [^"]*)".*/\2/p' "$1"
+      ;;
+    *)
+      readelf -p trait_symmap "$1" 2>/dev/null |
+        sed -nE 's/^[[:space:]]*\[[[:space:]]*[0-9a-f]+\][[:space:]]+(___trait_.*)/\1/p'
+      ;;
+  esac
+}
+
+list=0
+if [ "${1:-}" = "--list" ]; then
+  list=1
+  shift
+fi
+[ $# -ge 1 ] || usage
+map="$1"
+shift
+[ -r "$map" ] || { echo "$0: cannot read $map" >&2; exit 1; }
+
+if [ "$list" = 1 ]; then
+  read_map "$map"
+  exit 0
+fi
+
+[ $# -gt 0 ] || set -- -
+awk '
+  FILENAME == ARGV[1] {
+    if (!($1 in name)) name[$1] = $2
+    else if (index("|" name[$1] "|", "|" $2 "|") == 0) name[$1] = name[$1] "|" $2
+    next
+  }
+  {
+    line = $0
+    out = ""
+    while (match(line, /___trait_(sd|tt)_fn_[0-7]+/)) {
+      sym = substr(line, RSTART, RLENGTH)
+      out = out substr(line, 1, RSTART - 1) ((sym in name) ? name[sym] : sym)
+      line = substr(line, RSTART + RLENGTH)
+    }
+    print out line
+  }
+' <(read_map "$map") "$@"
@@ -7,6 +7,50 @@ CC="${1:-clang}"
 echo "Using compiler: $CC"
 overall_failed=0
 
+# Headers that two .c files of one program may both include: everything they
+# define must be static (or static inline), or the link fails on duplicates.
+link_headers=(trait.h traits/ord.h traits/iter.h traits/alloc.h traits/hash.h traits/clone.h traits/codec.h traits/fmt.h)
+
+# b.c also overrides a default between the two includes of a Forward impl
+# (e9's pattern); a.c calls that override, so it must keep external linkage.
+test_link() {
+  local dir
+  dir=$(mktemp -d)
+  for tu in a b; do
+    for h in "${link_headers[@]}"; do
+      echo "#include \"$h\""
+    done > "$dir/$tu.c"
+  done
+  cat >> "$dir/a.c" <<'C'
+typedef struct { int v; } Gauge;
+int Gauge_Probe_age(Gauge *self);
+int main(void) { Gauge g = { 41 }; return Gauge_Probe_age(&g) != 42; }
+C
+  cat >> "$dir/b.c" <<'C'
+#define ProbeSignature(Self) required(Self, int, get) defaults(Self, int, age)
+#define Dynamic
+#define Trait Probe
+#include "trait.h"
+#define For Default
+#define Impl Probe
+int def(age) { (void)self; return 0; }
+#include "trait.h"
+typedef struct { int v; } Gauge;
+#define For Gauge
+#define Impl Probe
+#define Forward
+#include "trait.h"
+int def(get) { return self->v; }
+#define Override_Gauge_Probe_age 1
+int def(age) { return call(Probe.get, self) + 1; }
+#include "trait.h"
+C
+  local rc=0
+  "$CC" -Wall -Wextra -Werror "$@" -I. "$dir/a.c" "$dir/b.c" -o "$dir/link" && "$dir/link" || rc=1
+  rm -rf "$dir"
+  return "$rc"
+}
+
 test_mode() {
   local label="$1"
   shift
@@ -33,6 +77,12 @@ test_mode() {
     fi
   done
 
+  echo "=== two translation units ==="
+  if ! test_link "$@"; then
+    echo "FAIL: link two TUs including ${link_headers[*]} (and a Forward override)"
+    mode_failed=1
+  fi
+
   if [ "$mode_failed" -ne 0 ]; then
     echo ""
     echo "SOME EXAMPLES FAILED ($label)"
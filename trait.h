@@ -7,7 +7,8 @@
 // SD SELF-INCLUDE LOOP BODY
 //
 // This branch is entered during the SD loop iteration.  For and Impl are still
-// defined.  ___TRAIT_SD_PASS is the current method index (0, 1, 2, ...).
+// defined.  ___TRAIT_SD_PASS is the current method index (0, 1, 2, ...);
+// the trait's generics, if any, follow its methods (see <Trait>Generics).
 //
 // Each iteration:
 //   1. Check sentinel → if past last method, stop looping.
@@ -195,7 +196,7 @@ ___TRAIT_SD_EMIT(___TRAIT_SD_SELECT(___TRAIT_SD_PASS, Impl))
 #endif
 #endif
 #endif
-// Increment pass counter (max 15 methods per trait)
+// Increment pass counter (the impl marker, then up to 30 methods and generics)
 #if   ___TRAIT_SD_PASS == 0
 #undef  ___TRAIT_SD_PASS
 #define ___TRAIT_SD_PASS 1
@@ -242,7 +243,55 @@ ___TRAIT_SD_EMIT(___TRAIT_SD_SELECT(___TRAIT_SD_PASS, Impl))
 #undef  ___TRAIT_SD_PASS
 #define ___TRAIT_SD_PASS 15
 #elif ___TRAIT_SD_PASS == 15
-#error "c-trait: too many methods per trait for SD (max 15)"
+#undef  ___TRAIT_SD_PASS
+#define ___TRAIT_SD_PASS 16
+#elif ___TRAIT_SD_PASS == 16
+#undef  ___TRAIT_SD_PASS
+#define ___TRAIT_SD_PASS 17
+#elif ___TRAIT_SD_PASS == 17
+#undef  ___TRAIT_SD_PASS
+#define ___TRAIT_SD_PASS 18
+#elif ___TRAIT_SD_PASS == 18
+#undef  ___TRAIT_SD_PASS
+#define ___TRAIT_SD_PASS 19
+#elif ___TRAIT_SD_PASS == 19
+#undef  ___TRAIT_SD_PASS
+#define ___TRAIT_SD_PASS 20
+#elif ___TRAIT_SD_PASS == 20
+#undef  ___TRAIT_SD_PASS
+#define ___TRAIT_SD_PASS 21
+#elif ___TRAIT_SD_PASS == 21
+#undef  ___TRAIT_SD_PASS
+#define ___TRAIT_SD_PASS 22
+#elif ___TRAIT_SD_PASS == 22
+#undef  ___TRAIT_SD_PASS
+#define ___TRAIT_SD_PASS 23
+#elif ___TRAIT_SD_PASS == 23
+#undef  ___TRAIT_SD_PASS
+#define ___TRAIT_SD_PASS 24
+#elif ___TRAIT_SD_PASS == 24
+#undef  ___TRAIT_SD_PASS
+#define ___TRAIT_SD_PASS 25
+#elif ___TRAIT_SD_PASS == 25
+#undef  ___TRAIT_SD_PASS
+#define ___TRAIT_SD_PASS 26
+#elif ___TRAIT_SD_PASS == 26
+#undef  ___TRAIT_SD_PASS
+#define ___TRAIT_SD_PASS 27
+#elif ___TRAIT_SD_PASS == 27
+#undef  ___TRAIT_SD_PASS
+#define ___TRAIT_SD_PASS 28
+#elif ___TRAIT_SD_PASS == 28
+#undef  ___TRAIT_SD_PASS
+#define ___TRAIT_SD_PASS 29
+#elif ___TRAIT_SD_PASS == 29
+#undef  ___TRAIT_SD_PASS
+#define ___TRAIT_SD_PASS 30
+#elif ___TRAIT_SD_PASS == 30
+#undef  ___TRAIT_SD_PASS
+#define ___TRAIT_SD_PASS 31
+#elif ___TRAIT_SD_PASS == 31
+#error "c-trait: too many methods and generics per trait for SD (max 30)"
 #endif
 // Self-include for next iteration
 #include "trait.h"
@@ -442,7 +491,8 @@ ___TRAIT_DYNSD_EMIT(___TRAIT_DYNSD_SELECT(___TRAIT_DYNSD_PASS, Impl))
 #endif
 #endif
 #endif
-// Increment DynSD pass counter (max 15 methods per trait)
+// Increment DynSD pass counter (max 31 entries per trait: own methods,
+// replayed direct-base methods and upcast targets)
 #if   ___TRAIT_DYNSD_PASS == 0
 #undef  ___TRAIT_DYNSD_PASS
 #define ___TRAIT_DYNSD_PASS 1
@@ -489,7 +539,55 @@ ___TRAIT_DYNSD_EMIT(___TRAIT_DYNSD_SELECT(___TRAIT_DYNSD_PASS, Impl))
 #undef  ___TRAIT_DYNSD_PASS
 #define ___TRAIT_DYNSD_PASS 15
 #elif ___TRAIT_DYNSD_PASS == 15
-#error "c-trait: too many methods per trait for DynSD (max 15)"
+#undef  ___TRAIT_DYNSD_PASS
+#define ___TRAIT_DYNSD_PASS 16
+#elif ___TRAIT_DYNSD_PASS == 16
+#undef  ___TRAIT_DYNSD_PASS
+#define ___TRAIT_DYNSD_PASS 17
+#elif ___TRAIT_DYNSD_PASS == 17
+#undef  ___TRAIT_DYNSD_PASS
+#define ___TRAIT_DYNSD_PASS 18
+#elif ___TRAIT_DYNSD_PASS == 18
+#undef  ___TRAIT_DYNSD_PASS
+#define ___TRAIT_DYNSD_PASS 19
+#elif ___TRAIT_DYNSD_PASS == 19
+#undef  ___TRAIT_DYNSD_PASS
+#define ___TRAIT_DYNSD_PASS 20
+#elif ___TRAIT_DYNSD_PASS == 20
+#undef  ___TRAIT_DYNSD_PASS
+#define ___TRAIT_DYNSD_PASS 21
+#elif ___TRAIT_DYNSD_PASS == 21
+#undef  ___TRAIT_DYNSD_PASS
+#define ___TRAIT_DYNSD_PASS 22
+#elif ___TRAIT_DYNSD_PASS == 22
+#undef  ___TRAIT_DYNSD_PASS
+#define ___TRAIT_DYNSD_PASS 23
+#elif ___TRAIT_DYNSD_PASS == 23
+#undef  ___TRAIT_DYNSD_PASS
+#define ___TRAIT_DYNSD_PASS 24
+#elif ___TRAIT_DYNSD_PASS == 24
+#undef  ___TRAIT_DYNSD_PASS
+#define ___TRAIT_DYNSD_PASS 25
+#elif ___TRAIT_DYNSD_PASS == 25
+#undef  ___TRAIT_DYNSD_PASS
+#define ___TRAIT_DYNSD_PASS 26
+#elif ___TRAIT_DYNSD_PASS == 26
+#undef  ___TRAIT_DYNSD_PASS
+#define ___TRAIT_DYNSD_PASS 27
+#elif ___TRAIT_DYNSD_PASS == 27
+#undef  ___TRAIT_DYNSD_PASS
+#define ___TRAIT_DYNSD_PASS 28
+#elif ___TRAIT_DYNSD_PASS == 28
+#undef  ___TRAIT_DYNSD_PASS
+#define ___TRAIT_DYNSD_PASS 29
+#elif ___TRAIT_DYNSD_PASS == 29
+#undef  ___TRAIT_DYNSD_PASS
+#define ___TRAIT_DYNSD_PASS 30
+#elif ___TRAIT_DYNSD_PASS == 30
+#undef  ___TRAIT_DYNSD_PASS
+#define ___TRAIT_DYNSD_PASS 31
+#elif ___TRAIT_DYNSD_PASS == 31
+#error "c-trait: too many methods and supertraits per trait for DynSD (max 31)"
 #endif
 // Self-include for next iteration
 #include "trait.h"
@@ -507,6 +605,21 @@ ___TRAIT_DYNSD_EMIT(___TRAIT_DYNSD_SELECT(___TRAIT_DYNSD_PASS, Impl))
 #undef Impl
 #else
 
+// ── <Trait>Static / <Trait>Dynamic marker: impls of a marked trait follow
+//    the marker whatever trait was defined last (restored at the end of the
+//    block).
+#if ___TRAIT_IS_STATIC_MARK(Impl)
+#ifndef ___TRAIT_IS_STATIC_CURRENT
+#define ___TRAIT_IS_STATIC_CURRENT 1
+#define ___TRAIT_STATIC_IMPL_SET 1
+#endif
+#elif ___TRAIT_IS_DYNAMIC_MARK(Impl)
+#ifdef ___TRAIT_IS_STATIC_CURRENT
+#undef ___TRAIT_IS_STATIC_CURRENT
+#define ___TRAIT_DYNAMIC_IMPL_SET 1
+#endif
+#endif
+
 #ifdef Forward
 // ═════════════════════════════════════════════════════════════════════════════
 // FORWARD DECLARATION PATH
@@ -546,7 +659,10 @@ ___TRAIT_PASTE(Impl, Signature)((Impl, FWDDECL))
 // When ___TRAIT_IS_STATIC_CURRENT is set, defaults/impl/DynSD/enforce are skipped.
 // ═════════════════════════════════════════════════════════════════════════════
 // ── DFL/SDFL storage-class: must be defined before ___TRAIT_DFL()/___TRAIT_SDFL()
-//    in the same include pass so the wrapper-linkage matches FWDDECL.
+//    in the same include pass so the wrapper linkage matches FWDDECL.  In the
+//    normal path wrappers are internal, so an unused one (and the vtable it
+//    references) can be dropped; after Forward they are external, because
+//    FWDDECL had to declare every default slot extern.
 #undef ___TRAIT_DFL_STORAGE
 #ifdef ___TRAIT_FWDIMPL_DONE
 #define ___TRAIT_DFL_STORAGE ___TRAIT_UNUSED
@@ -562,6 +678,7 @@ typedef struct { int ___trait_impls_check_; } glue4(___TRAIT_IMPLS_TYPE_, For, _
 #ifndef ___TRAIT_IS_STATIC_CURRENT
 ___TRAIT_DFL()
 ___TRAIT_IMPL()
+___TRAIT_META_IMPL()
 // ── TT (dyn) registration: emit pair type + wrapper for this impl ──
 ___TRAIT_TT_EMIT()
 // ── Increment 6-digit octal TT counter ──────────────────────────────
@@ -733,12 +850,25 @@ ___TRAIT_SDFL()
 #undef ___TRAIT_FWDIMPL_DONE
 #endif
 
+#ifdef TRAIT_STATS
+#pragma message "trait.h: impl " ___TRAIT_STR(Impl) " for " ___TRAIT_STR(For) ": SD slots " ___TRAIT_SD_OCTAL " (octal), TT slots " ___TRAIT_TT_OCTAL " (octal)"
+#endif
+
 // ── Enforce extends: verify base traits are implemented ─────────────────────
 // Skip for static traits (no vtable to reference for enforcement).
 #ifndef ___TRAIT_IS_STATIC_CURRENT
 ___TRAIT_PASTE(Impl, Signature)((Impl, ENFORCE))
 #endif
 
+#ifdef ___TRAIT_STATIC_IMPL_SET
+#undef ___TRAIT_STATIC_IMPL_SET
+#undef ___TRAIT_IS_STATIC_CURRENT
+#endif
+#ifdef ___TRAIT_DYNAMIC_IMPL_SET
+#undef ___TRAIT_DYNAMIC_IMPL_SET
+#define ___TRAIT_IS_STATIC_CURRENT 1
+#endif
+
 #undef For
 #undef Impl
 #endif // Forward
@@ -772,29 +902,43 @@ ___TRAIT_PASTE(Impl, Signature)((Impl, ENFORCE))
 // Traits are static by default (no vtable, no DynTrait, no dynamic dispatch).
 // #define Dynamic before #define Trait opts into full dynamic features:
 // vtable, DynTrait, DFL defaults, impl(), ENFORCE, DynSD.
-// The flag persists until the next trait definition clears it.
+// The flag persists until the next trait definition clears it, and impls
+// follow the flag.  A static trait that also defines
+//   #define <Trait>Static 1
+// (e.g. one shipped in a shared header) leaves the flag as it found it;
+// its impls are recognised as static by the marker instead.
+// #define <Trait>Dynamic 1 does the same for a dynamic trait (and implies
+// #define Dynamic).
+#if ___TRAIT_IS_FLAG_MARK(Trait) && defined(___TRAIT_IS_STATIC_CURRENT)
+#define ___TRAIT_STATIC_SAVED 1
+#endif
 #undef ___TRAIT_IS_STATIC_CURRENT
-#ifndef Dynamic
-#define ___TRAIT_IS_STATIC_CURRENT 1
-#else
+#if defined(Dynamic) || ___TRAIT_IS_DYNAMIC_MARK(Trait)
 #undef Dynamic
+#else
+#define ___TRAIT_IS_STATIC_CURRENT 1
 #endif
 
 #ifndef ___TRAIT_IS_STATIC_CURRENT
 typedef struct {
-  ___TRAIT_TRAIT_PASTE(Trait)((Trait, FN))
+  ___TRAIT_VTABLE_FIELDS(Trait)
 } glue(Trait, _vtable);
 typedef struct {
   void *self;
   const glue(Trait, _vtable) *vt;
 } glue(Dyn, Trait);
+typedef struct { char _; } glue(Trait, ___up_t);
+___TRAIT_META_DEF(Trait)
 #endif
 ___TRAIT_TRAIT_PASTE(Trait)((Trait, STAG))
 typedef struct {
   ___TRAIT_TRAIT_PASTE(Trait)((Trait, SSEL))
+  char ___trait_marker_; // keeps a method-less (marker) trait's selector non-empty
 } glue(Trait, ___sel_t);
 ___TRAIT_UNUSED static ___TRAIT_CONSTEXPR glue(Trait, ___sel_t)
     Trait = {0};
+enum { glue(Trait, ___methods) = 0 ___TRAIT_TRAIT_PASTE(Trait)((Trait, MCOUNT)) };
+enum { glue(Trait, ___sd_mark) = TRAIT_SD_SLOTS };
 
 // ── DynSD: emit vtable-dispatch wrappers at trait declaration ────────────
 // Registered once per trait (not per-impl) so that _Generic pair types
@@ -811,19 +955,96 @@ ___TRAIT_UNUSED static ___TRAIT_CONSTEXPR glue(Trait, ___sel_t)
 #undef Impl
 #undef For
 #endif
+enum { glue(Trait, ___dyn_slots) = TRAIT_SD_SLOTS - glue(Trait, ___sd_mark) };
+#ifdef TRAIT_STATS
+#pragma message "trait.h: trait " ___TRAIT_STR(Trait) ": SD slots " ___TRAIT_SD_OCTAL " (octal), TT slots " ___TRAIT_TT_OCTAL " (octal)"
+#endif
+
+#if ___TRAIT_IS_FLAG_MARK(Trait)
+#undef ___TRAIT_IS_STATIC_CURRENT
+#ifdef ___TRAIT_STATIC_SAVED
+#undef ___TRAIT_STATIC_SAVED
+#define ___TRAIT_IS_STATIC_CURRENT 1
+#endif
+#endif
 
 #undef Trait
 
 #endif
 #endif
 
+// ── Reinclude: multi-trait object ───────────────────────────────────────────
+// Usage:
+//   #define Multi Animal, Show
+//   #include "trait.h"
+//
+// Declares Dyn2(Animal, Show) — one self pointer plus one vtable pointer per
+// member trait — and runs the DynSD loop once per member with the object type
+// and vtable member redirected (___TRAIT_DYNSD_SELF / ___TRAIT_DYNSD_VT), so
+// call(Animal.x, &m) and call(Show.y, &m) resolve at compile time to
+// m.Animal->x and m.Show->y.  Two to four dynamic traits are supported.
+// ─────────────────────────────────────────────────────────────────────────────
+#ifdef Multi
+#ifndef For
+
+___TRAIT_MULTI_STRUCT(Multi)
+
+#undef  ___TRAIT_DYNSD_SELF
+#define ___TRAIT_DYNSD_SELF ___TRAIT_MULTI_NAME(Multi)
+#undef  ___TRAIT_DYNSD_VT
+#define ___TRAIT_DYNSD_VT Impl
+#define For void
+#define ___TRAIT_DYNSD_ACTIVE 1
+
+#define Impl ___TRAIT_MULTI_AT(0, Multi)
+#define ___TRAIT_DYNSD_PASS 0
+#include "trait.h"
+#undef ___TRAIT_DYNSD_PASS
+#undef Impl
+
+#define Impl ___TRAIT_MULTI_AT(1, Multi)
+#define ___TRAIT_DYNSD_PASS 0
+#include "trait.h"
+#undef ___TRAIT_DYNSD_PASS
+#undef Impl
+
+#if ___TRAIT_MULTI_COUNT(Multi) > 2
+#define Impl ___TRAIT_MULTI_AT(2, Multi)
+#define ___TRAIT_DYNSD_PASS 0
+#include "trait.h"
+#undef ___TRAIT_DYNSD_PASS
+#undef Impl
+#endif
+
+#if ___TRAIT_MULTI_COUNT(Multi) > 3
+#define Impl ___TRAIT_MULTI_AT(3, Multi)
+#define ___TRAIT_DYNSD_PASS 0
+#include "trait.h"
+#undef ___TRAIT_DYNSD_PASS
+#undef Impl
+#endif
+
+#undef ___TRAIT_DYNSD_ACTIVE
+#undef For
+#undef  ___TRAIT_DYNSD_SELF
+#define ___TRAIT_DYNSD_SELF glue(Dyn, Impl)
+#undef  ___TRAIT_DYNSD_VT
+#define ___TRAIT_DYNSD_VT vt
+#undef Multi
+
+#endif
+#endif
+
 #ifndef TRAIT_ALT_H
 #define TRAIT_ALT_H
 
 // GNU C extensions used: ##__VA_ARGS__ (replaced by __VA_OPT__ in C23),
 // __typeof__ (replaced by typeof in C23).  No __attribute__((weak)) —
 // default method overrides use the PROBE trick + user-declared
-// #define Override_<Type>_<Trait>_<Method> 1 instead.
+// #define Override_<Type>_<Trait>_<Method> 1 instead.  (The opt-in
+// TRAIT_PROFILE, TRAIT_TRACE and TRAIT_META builds additionally use section
+// attributes, __atomic, (TRAIT_TRACE, TRAIT_META) weak symbols and
+// (TRAIT_TRACE) __thread.)
 
 // -----------------------------------------------------------------------------
 // Pasting / concatenation helpers
@@ -845,6 +1066,10 @@ ___TRAIT_UNUSED static ___TRAIT_CONSTEXPR glue(Trait, ___sel_t)
 #define ___TRAIT_PASTE_HELPER(a, b) a##b
 #define ___TRAIT_PASTE(a, b) ___TRAIT_PASTE_HELPER(a, b)
 
+// Stringify after expansion.
+#define ___TRAIT_STR_(x) #x
+#define ___TRAIT_STR(x) ___TRAIT_STR_(x)
+
 // -----------------------------------------------------------------------------
 // Override detection (PROBE trick — 100% standard C)
 //
@@ -1027,7 +1252,31 @@ ___TRAIT_UNUSED static ___TRAIT_CONSTEXPR glue(Trait, ___sel_t)
   ___TRAIT_CHECK(___TRAIT_CAT(___TRAIT_IS_DEFAULT_TOKEN_, For))
 
 #define ___TRAIT_IS_STATIC_TOKEN_1 ___TRAIT_PROBE()
-#define ___TRAIT_IS_STATIC() ___TRAIT_CHECK(___TRAIT_CAT(___TRAIT_IS_STATIC_TOKEN_, ___TRAIT_IS_STATIC_CURRENT))
+#define ___TRAIT_IS_STATIC()                                                       \
+  glue(___TRAIT_ANDNOT_,                                                           \
+  glue(glue(___TRAIT_OR_, glue(___TRAIT_CHECK(___TRAIT_CAT(___TRAIT_IS_STATIC_TOKEN_, \
+                                                      ___TRAIT_IS_STATIC_CURRENT)), \
+                          ___TRAIT_IS_STATIC_MARK(Impl))),                         \
+       ___TRAIT_IS_DYNAMIC_MARK(Impl)))
+#define ___TRAIT_OR_00 0
+#define ___TRAIT_OR_01 1
+#define ___TRAIT_OR_10 1
+#define ___TRAIT_OR_11 1
+#define ___TRAIT_ANDNOT_00 0
+#define ___TRAIT_ANDNOT_01 0
+#define ___TRAIT_ANDNOT_10 1
+#define ___TRAIT_ANDNOT_11 0
+// 1 if the trait defines <Trait>Static as 1 (see the trait definition block).
+#define ___TRAIT_IS_STATIC_MARK(T)                                                 \
+  ___TRAIT_IS_PROBE(___TRAIT_OVR_TEST(glue(T, Static)))
+// 1 if the trait defines <Trait>Dynamic as 1.  Pasted directly: the bare
+// Dynamic may itself be a (usually empty) macro at this point.
+#define ___TRAIT_DYNAMIC_NAME(T) ___TRAIT_DYNAMIC_NAME_I(T)
+#define ___TRAIT_DYNAMIC_NAME_I(T) T##Dynamic
+#define ___TRAIT_IS_DYNAMIC_MARK(T)                                                \
+  ___TRAIT_IS_PROBE(___TRAIT_OVR_TEST(___TRAIT_DYNAMIC_NAME(T)))
+#define ___TRAIT_IS_FLAG_MARK(T)                                                   \
+  glue(___TRAIT_OR_, glue(___TRAIT_IS_STATIC_MARK(T), ___TRAIT_IS_DYNAMIC_MARK(T)))
 
 // -----------------------------------------------------------------------------
 // Vtable / trait object helper names
@@ -1065,6 +1314,82 @@ ___TRAIT_UNUSED static ___TRAIT_CONSTEXPR glue(Trait, ___sel_t)
 #define ___TRAIT_ACT_FN_DEFAULT_1(Type, Ret, Name, ...)                          \
   Ret (*Name)(const void *, ##__VA_ARGS__);
 
+// -----------------------------------------------------------------------------
+// Hot/cold layout: hot(Self) / cold(Self)
+//
+// The vtable struct is emitted in three passes — FNHOT, FN, FNCOLD — so
+// annotated entries move to the front or back while unannotated ones keep
+// signature order:
+//   #define ShapeSignature(Self)
+//     extends(Named, cold(Self))
+//     required(hot(immutable(Self)), double, area)
+//     required(cold(Self), void, resize, double)
+//   → typedef struct { double (*area)(const void *); ...; Named_vtable Named;
+//                      void (*resize)(void *, double); } Shape_vtable;
+// hot/cold rewrite the SelfSpec action: in its own pass the entry is emitted
+// as FN, in the other two passes as FNSKIP; every other action passes through
+// unchanged, so call() and BIND (which go by field name) are unaffected.
+// Any hot entry also aligns each For##_Trait##_vtable object to
+// TRAIT_CACHE_LINE bytes (ALIGN → ALIGNHOT), so the hot block starts on a
+// cache line boundary.
+// -----------------------------------------------------------------------------
+#ifndef TRAIT_CACHE_LINE
+#define TRAIT_CACHE_LINE 64
+#endif
+
+#define hot(SelfSpec) ___TRAIT_LAYOUT(SelfSpec, HOT)
+#define cold(SelfSpec) ___TRAIT_LAYOUT(SelfSpec, COLD)
+#define ___TRAIT_LAYOUT(SelfSpec, K)                                               \
+  glue(___TRAIT_LAYOUT_, ___TRAIT_IS_IMMUTABLE(SelfSpec))(SelfSpec, K)
+#define ___TRAIT_LAYOUT_0(SelfSpec, K)                                             \
+  (___TRAIT_GET_TYPE(SelfSpec),                                                    \
+   ___TRAIT_LAYOUT_MAP(K, ___TRAIT_GET_ACTION(SelfSpec)))
+#define ___TRAIT_LAYOUT_1(SelfSpec, K)                                             \
+  (___TRAIT_IMMUTABLE, ___TRAIT_LAYOUT_0(___TRAIT_SELF_SECOND SelfSpec, K))
+#define ___TRAIT_LAYOUT_PICK(...) ___TRAIT_SECOND(__VA_ARGS__)
+#define ___TRAIT_LAYOUT_MAP(K, Action)                                             \
+  ___TRAIT_LAYOUT_PICK(glue4(___TRAIT_LAYOUT_, K, _, Action), Action, ~)
+#define ___TRAIT_LAYOUT_HOT_FNHOT ~, FN
+#define ___TRAIT_LAYOUT_HOT_FN ~, FNSKIP
+#define ___TRAIT_LAYOUT_HOT_FNCOLD ~, FNSKIP
+#define ___TRAIT_LAYOUT_HOT_ALIGN ~, ALIGNHOT
+#define ___TRAIT_LAYOUT_COLD_FNCOLD ~, FN
+#define ___TRAIT_LAYOUT_COLD_FN ~, FNSKIP
+#define ___TRAIT_LAYOUT_COLD_FNHOT ~, FNSKIP
+
+#define ___TRAIT_ACT_FNHOT_REQUIRE_0(Type, Ret, Name, ...)
+#define ___TRAIT_ACT_FNHOT_REQUIRE_1(Type, Ret, Name, ...)
+#define ___TRAIT_ACT_FNHOT_DEFAULT_0(Type, Ret, Name, ...)
+#define ___TRAIT_ACT_FNHOT_DEFAULT_1(Type, Ret, Name, ...)
+#define ___TRAIT_ACT_FNCOLD_REQUIRE_0(Type, Ret, Name, ...)
+#define ___TRAIT_ACT_FNCOLD_REQUIRE_1(Type, Ret, Name, ...)
+#define ___TRAIT_ACT_FNCOLD_DEFAULT_0(Type, Ret, Name, ...)
+#define ___TRAIT_ACT_FNCOLD_DEFAULT_1(Type, Ret, Name, ...)
+#define ___TRAIT_ACT_FNSKIP_REQUIRE_0(Type, Ret, Name, ...)
+#define ___TRAIT_ACT_FNSKIP_REQUIRE_1(Type, Ret, Name, ...)
+#define ___TRAIT_ACT_FNSKIP_DEFAULT_0(Type, Ret, Name, ...)
+#define ___TRAIT_ACT_FNSKIP_DEFAULT_1(Type, Ret, Name, ...)
+#define ___TRAIT_ACT_ALIGN_REQUIRE_0(Type, Ret, Name, ...)
+#define ___TRAIT_ACT_ALIGN_REQUIRE_1(Type, Ret, Name, ...)
+#define ___TRAIT_ACT_ALIGN_DEFAULT_0(Type, Ret, Name, ...)
+#define ___TRAIT_ACT_ALIGN_DEFAULT_1(Type, Ret, Name, ...)
+#define ___TRAIT_ACT_ALIGNHOT_REQUIRE_0(Type, Ret, Name, ...) ___TRAIT_ALIGN_HOT
+#define ___TRAIT_ACT_ALIGNHOT_REQUIRE_1(Type, Ret, Name, ...) ___TRAIT_ALIGN_HOT
+#define ___TRAIT_ACT_ALIGNHOT_DEFAULT_0(Type, Ret, Name, ...) ___TRAIT_ALIGN_HOT
+#define ___TRAIT_ACT_ALIGNHOT_DEFAULT_1(Type, Ret, Name, ...) ___TRAIT_ALIGN_HOT
+
+// Repeated alignment specifiers are allowed; the strictest one applies.
+#if ___TRAIT_CE
+#define ___TRAIT_ALIGN_HOT __attribute__((__aligned__(TRAIT_CACHE_LINE)))
+#else
+#define ___TRAIT_ALIGN_HOT _Alignas(TRAIT_CACHE_LINE)
+#endif
+
+#define ___TRAIT_VTABLE_FIELDS(T)                                                  \
+  ___TRAIT_PASTE(T, Signature)((T, FNHOT))                                         \
+  ___TRAIT_PASTE(T, Signature)((T, FN))                                            \
+  ___TRAIT_PASTE(T, Signature)((T, FNCOLD))
+
 // -----------------------------------------------------------------------------
 // Actions: STAG (per-method unique tag typedef for selector struct)
 // -----------------------------------------------------------------------------
@@ -1089,6 +1414,508 @@ ___TRAIT_UNUSED static ___TRAIT_CONSTEXPR glue(Trait, ___sel_t)
 #define ___TRAIT_ACT_SSEL_DEFAULT_1(Type, Ret, Name, ...)                        \
   glue5(___sel_, Type, _, Name, _t) Name;
 
+// -----------------------------------------------------------------------------
+// Actions: MCOUNT (`+ 1` per method; extends adds the base's count)
+// -----------------------------------------------------------------------------
+#define ___TRAIT_ACT_MCOUNT_REQUIRE_0(Type, Ret, Name, ...) + 1
+#define ___TRAIT_ACT_MCOUNT_REQUIRE_1(Type, Ret, Name, ...) + 1
+#define ___TRAIT_ACT_MCOUNT_DEFAULT_0(Type, Ret, Name, ...) + 1
+#define ___TRAIT_ACT_MCOUNT_DEFAULT_1(Type, Ret, Name, ...) + 1
+
+// -----------------------------------------------------------------------------
+// Runtime introspection: per-trait method tables (META / METABASE)
+//
+// Every dynamic trait gets a static const description of its vtable:
+//   const struct trait_meta *m = trait_meta(Pet);
+//   m->methods[0]  → {"name", offsetof(Pet_vtable, name), 1, 0}
+//   m->bases[0]    → {trait_meta(Animal), offsetof(Pet_vtable, Animal), 0}
+// Rows follow signature order (hot/cold only move the offsets); base methods
+// are reached through bases[] instead of being repeated.  The tables live in
+// rodata and are dropped when unused, so dispatch is unaffected.
+// trait_meta_lookup(m, vt, "get_snacks") resolves a method by name through
+// the bases (following extends_shared pointers) to the function in vt.
+// -----------------------------------------------------------------------------
+#include <stddef.h>
+
+struct trait_method_meta {
+  const char *name;
+  size_t offset;
+  int is_const;
+  int arity; // arguments after self
+};
+
+struct trait_meta;
+struct trait_base_meta {
+  const struct trait_meta *base;
+  size_t offset;
+  int shared; // 1: extends_shared, the field holds a pointer to the base vtable
+};
+
+struct trait_meta {
+  const char *name;
+  size_t vtable_size;
+  const struct trait_method_meta *methods;
+  unsigned n_methods;
+  const struct trait_base_meta *bases;
+  unsigned n_bases;
+};
+
+typedef void (*trait_meta_fn)(void);
+
+#define trait_meta(T) (&glue(T, ___meta))
+
+#define ___TRAIT_ACT_META_REQUIRE_0(Type, Ret, Name, ...)                          \
+  {#Name, offsetof(___TRAIT_VTTYPE(Type), Name), 0, ___TRAIT_NARG(__VA_ARGS__)},
+#define ___TRAIT_ACT_META_REQUIRE_1(Type, Ret, Name, ...)                          \
+  {#Name, offsetof(___TRAIT_VTTYPE(Type), Name), 1, ___TRAIT_NARG(__VA_ARGS__)},
+#define ___TRAIT_ACT_META_DEFAULT_0(Type, Ret, Name, ...)                          \
+  {#Name, offsetof(___TRAIT_VTTYPE(Type), Name), 0, ___TRAIT_NARG(__VA_ARGS__)},
+#define ___TRAIT_ACT_META_DEFAULT_1(Type, Ret, Name, ...)                          \
+  {#Name, offsetof(___TRAIT_VTTYPE(Type), Name), 1, ___TRAIT_NARG(__VA_ARGS__)},
+#define ___TRAIT_ACT_METABASE_REQUIRE_0(Type, Ret, Name, ...)
+#define ___TRAIT_ACT_METABASE_REQUIRE_1(Type, Ret, Name, ...)
+#define ___TRAIT_ACT_METABASE_DEFAULT_0(Type, Ret, Name, ...)
+#define ___TRAIT_ACT_METABASE_DEFAULT_1(Type, Ret, Name, ...)
+
+// Stable type ids: trait_type_id(Dog) is the 64-bit FNV-1a hash of "Dog".
+// The macro folds to a constant (usable in static initializers) for names of
+// up to 128 bytes; a longer name does not compile (negative array size).
+// trait_type_id_of("Dog") hashes the whole string at runtime, whatever its
+// length, and agrees with the macro, e.g. for a tag read off the wire.
+#define trait_type_id(T) ___TRAIT_ID_HASH(___TRAIT_STR(T))
+#define ___TRAIT_ID_P 1099511628211ull
+// Past the end of s a step xors 0 and multiplies by 1, leaving h unchanged.
+#define ___TRAIT_ID_C(s, i)                                                        \
+  ((i) < sizeof(s) ? (unsigned long long)(unsigned char)(s)[(i) < sizeof(s) ? (i) : 0] \
+                   : 0ull)
+#define ___TRAIT_ID_1(h, s, i)                                                     \
+  (((h) ^ ___TRAIT_ID_C(s, i)) * ((i) < sizeof(s) - 1 ? ___TRAIT_ID_P : 1ull))
+#define ___TRAIT_ID_4(h, s, i)                                                     \
+  ___TRAIT_ID_1(___TRAIT_ID_1(___TRAIT_ID_1(___TRAIT_ID_1(h, s, i), s, i + 1),     \
+                              s, i + 2), s, i + 3)
+#define ___TRAIT_ID_16(h, s, i)                                                    \
+  ___TRAIT_ID_4(___TRAIT_ID_4(___TRAIT_ID_4(___TRAIT_ID_4(h, s, i), s, i + 4),     \
+                              s, i + 8), s, i + 12)
+#define ___TRAIT_ID_64(h, s, i)                                                    \
+  ___TRAIT_ID_16(___TRAIT_ID_16(___TRAIT_ID_16(___TRAIT_ID_16(h, s, i), s, i + 16), \
+                                s, i + 32), s, i + 48)
+#define ___TRAIT_ID_HASH(s)                                                        \
+  (___TRAIT_ID_64(___TRAIT_ID_64(14695981039346656037ull, s, 0), s, 64) +          \
+   0 * sizeof(char[sizeof(s) <= 129 ? 1 : -1]))
+
+___TRAIT_UNUSED static unsigned long long trait_type_id_of(const char *name) {
+  unsigned long long h = 14695981039346656037ull;
+  for (; *name; name++)
+    h = (h ^ (unsigned char)*name) * ___TRAIT_ID_P;
+  return h;
+}
+
+___TRAIT_UNUSED static int ___trait_meta_streq(const char *a, const char *b) {
+  while (*a && *a == *b) a++, b++;
+  return *a == *b;
+}
+
+// -DTRAIT_META also lists the implementing types of each trait.  Every
+// (For, Impl) registration places a pointer to a trait_impl_meta record in
+// the section trait_impls_<Trait>; the linker gathers them from all TUs:
+//   for (const struct trait_impl_meta *const *it = trait_impls_begin(Animal);
+//        it < trait_impls_end(Animal); it++)
+//     printf("%s %p\n", (*it)->type, (*it)->vtable);
+// The same record is also placed in the section trait_impls, which lists
+// every impl linked into the image (executable or shared object), whatever
+// trait it belongs to:
+//   for (const struct trait_impl_meta *const *it = trait_registry_begin();
+//        it < trait_registry_end(); it++)
+//     printf("%s: %s\n", (*it)->type, (*it)->trait->name);
+// Both lists are assembled by the linker: no constructors, no startup work.
+// Order is link order.  Requires GCC/Clang and an ELF linker, like
+// TRAIT_PROFILE; the start/stop symbols are weak, so a trait without impls
+// yields an empty range.  Impl blocks compiled into several TUs (e.g. from a
+// shared header) are listed once per TU, each with its own vtable copy.
+#ifdef TRAIT_META
+#include <stdio.h>
+#include <stdlib.h>
+
+struct trait_impl_meta {
+  const char *type;
+  const struct trait_meta *trait;
+  const void *vtable;
+  size_t size; // sizeof(For)
+};
+
+#define trait_impls_begin(T)                                                       \
+  ((const struct trait_impl_meta *const *)glue(__start_trait_impls_, T))
+#define trait_impls_end(T)                                                         \
+  ((const struct trait_impl_meta *const *)glue(__stop_trait_impls_, T))
+
+#define trait_registry_begin()                                                     \
+  ((const struct trait_impl_meta *const *)__start_trait_impls)
+#define trait_registry_end()                                                       \
+  ((const struct trait_impl_meta *const *)__stop_trait_impls)
+
+extern const struct trait_impl_meta *__start_trait_impls[] __attribute__((__weak__));
+extern const struct trait_impl_meta *__stop_trait_impls[] __attribute__((__weak__));
+
+// One line per impl: type, trait, vtable address, sizeof(type).
+___TRAIT_UNUSED static void trait_registry_dump(FILE *out) {
+  for (const struct trait_impl_meta *const *it = trait_registry_begin();
+       it < trait_registry_end(); it++)
+    fprintf(out, "%s %s %p %zu\n", (*it)->type, (*it)->trait->name, (*it)->vtable,
+            (*it)->size);
+}
+
+// trait_lookup(type_id, Trait) → const Trait_vtable * (NULL if that type
+// does not implement Trait), with one displacement load and one probe:
+//   const Animal_vtable *vt = trait_lookup(tag, Animal);
+//   if (vt) obj = (DynAnimal){buf, vt};
+// The first call builds a perfect hash over the registry by hash and
+// displace (CHD): keys fall into buckets of about four, and buckets are
+// placed largest first, each with the first displacement d that sends all of
+// its keys to free slots.  A key's slot is hash(key, disp[bucket]); the table
+// has n * 5/4 slots rounded up to a power of two, and the build is linear in
+// n in expectation.  It is published with a CAS; threads racing on the first
+// call each build one and all but the winner free theirs.  Repeated
+// registrations of one impl (several TUs) collapse into one key; two
+// different (type, trait) names with the same pair of ids abort the build.
+struct trait_lookup_slot {
+  unsigned long long type_id, trait_id;
+  const void *vtable;
+};
+
+struct trait_lookup_table {
+  unsigned bits, bucket_bits, n;
+  unsigned *disp; // 1 << bucket_bits displacements, after the slots
+  struct trait_lookup_slot slot[];
+};
+
+__attribute__((__weak__)) struct trait_lookup_table *trait_lookup_table;
+
+#define trait_lookup(type_id, T)                                                   \
+  ((const ___TRAIT_VTTYPE(T) *)___trait_lookup((type_id), trait_type_id(T)))
+
+___TRAIT_UNUSED static unsigned long long ___trait_lookup_key(unsigned long long type_id,
+                                                              unsigned long long trait_id) {
+  unsigned long long k = (type_id ^ (trait_id >> 29)) * 0x9E3779B97F4A7C15ull;
+  return k ^ trait_id;
+}
+
+___TRAIT_UNUSED static unsigned ___trait_lookup_bucket(unsigned long long key, unsigned bits) {
+  return (unsigned)((key * 0xD6E8FEB86659FD93ull) >> (64 - bits));
+}
+
+___TRAIT_UNUSED static unsigned ___trait_lookup_index(unsigned long long key, unsigned d,
+                                                      unsigned bits) {
+  unsigned long long k = key + d * 0x9E3779B97F4A7C15ull;
+  k = (k ^ (k >> 30)) * 0xBF58476D1CE4E5B9ull;
+  k = (k ^ (k >> 27)) * 0x94D049BB133111EBull;
+  return (unsigned)((k ^ (k >> 31)) >> (64 - bits));
+}
+
+struct ___trait_lookup_key {
+  unsigned long long type_id, trait_id, key;
+  const struct trait_impl_meta *r;
+  unsigned bucket, bucket_n;
+};
+
+___TRAIT_UNUSED static int ___trait_lookup_id_cmp(const void *a, const void *b) {
+  const struct ___trait_lookup_key *x = (const struct ___trait_lookup_key *)a;
+  const struct ___trait_lookup_key *y = (const struct ___trait_lookup_key *)b;
+  if (x->type_id != y->type_id)
+    return x->type_id < y->type_id ? -1 : 1;
+  return x->trait_id < y->trait_id ? -1 : x->trait_id > y->trait_id;
+}
+
+// Largest buckets first, each bucket's keys together.
+___TRAIT_UNUSED static int ___trait_lookup_bucket_cmp(const void *a, const void *b) {
+  const struct ___trait_lookup_key *x = (const struct ___trait_lookup_key *)a;
+  const struct ___trait_lookup_key *y = (const struct ___trait_lookup_key *)b;
+  if (x->bucket_n != y->bucket_n)
+    return x->bucket_n > y->bucket_n ? -1 : 1;
+  return x->bucket < y->bucket ? -1 : x->bucket > y->bucket;
+}
+
+// Places keys k[0..n) (grouped by bucket) in t, or returns 0 if some bucket
+// found no displacement below 2^16.
+___TRAIT_UNUSED static int ___trait_lookup_place(struct trait_lookup_table *t,
+                                                 const struct ___trait_lookup_key *k,
+                                                 unsigned n) {
+  for (unsigned i = 0, j; i < n; i = j) {
+    for (j = i; j < n && k[j].bucket == k[i].bucket; j++) {}
+    unsigned d = 0, m = i;
+    for (; d < 1u << 16; d++) {
+      for (m = i; m < j; m++) {
+        struct trait_lookup_slot *s = &t->slot[___trait_lookup_index(k[m].key, d, t->bits)];
+        if (s->vtable)
+          break;
+        s->type_id = k[m].type_id;
+        s->trait_id = k[m].trait_id;
+        s->vtable = k[m].r->vtable;
+      }
+      if (m == j)
+        break;
+      while (m-- > i) // undo this attempt
+        t->slot[___trait_lookup_index(k[m].key, d, t->bits)].vtable = NULL;
+    }
+    if (d == 1u << 16)
+      return 0;
+    t->disp[k[i].bucket] = d;
+  }
+  return 1;
+}
+
+___TRAIT_UNUSED static struct trait_lookup_table *___trait_lookup_build(void) {
+  unsigned n = (unsigned)(trait_registry_end() - trait_registry_begin()), u = 0;
+  struct ___trait_lookup_key *k =
+      (struct ___trait_lookup_key *)malloc((n ? n : 1) * sizeof *k);
+  if (!k)
+    return NULL;
+  for (unsigned i = 0; i < n; i++) {
+    k[i].r = trait_registry_begin()[i];
+    k[i].type_id = trait_type_id_of(k[i].r->type);
+    k[i].trait_id = trait_type_id_of(k[i].r->trait->name);
+  }
+  qsort(k, n, sizeof *k, ___trait_lookup_id_cmp);
+  for (unsigned i = 0; i < n; i++) {
+    if (u && k[i].type_id == k[u - 1].type_id && k[i].trait_id == k[u - 1].trait_id) {
+      if (___trait_meta_streq(k[i].r->type, k[u - 1].r->type) &&
+          ___trait_meta_streq(k[i].r->trait->name, k[u - 1].r->trait->name))
+        continue; // the same impl, registered by another TU
+      fprintf(stderr, "trait.h: trait_lookup: impl %s for %s and impl %s for %s "
+                      "have the same ids; rename one\n",
+              k[u - 1].r->trait->name, k[u - 1].r->type, k[i].r->trait->name, k[i].r->type);
+      abort();
+    }
+    k[u++] = k[i];
+  }
+  unsigned bits = 1, bucket_bits = 1;
+  while ((1u << bits) < u + u / 4) bits++;
+  while ((4u << bucket_bits) < u) bucket_bits++;
+  for (unsigned i = 0; i < u; i++) {
+    k[i].key = ___trait_lookup_key(k[i].type_id, k[i].trait_id);
+    k[i].bucket = ___trait_lookup_bucket(k[i].key, bucket_bits);
+  }
+  unsigned *count = (unsigned *)calloc(1u << bucket_bits, sizeof *count);
+  if (!count) {
+    free(k);
+    return NULL;
+  }
+  for (unsigned i = 0; i < u; i++) count[k[i].bucket]++;
+  for (unsigned i = 0; i < u; i++) k[i].bucket_n = count[k[i].bucket];
+  free(count);
+  qsort(k, u, sizeof *k, ___trait_lookup_bucket_cmp);
+  for (; bits < 31; bits++) {
+    struct trait_lookup_table *t = (struct trait_lookup_table *)calloc(
+        1, sizeof *t + (sizeof(struct trait_lookup_slot) << bits) +
+               (sizeof(unsigned) << bucket_bits));
+    if (!t)
+      break;
+    t->bits = bits;
+    t->bucket_bits = bucket_bits;
+    t->n = u;
+    t->disp = (unsigned *)(void *)(t->slot + (1u << bits));
+    if (___trait_lookup_place(t, k, u)) {
+      free(k);
+      return t;
+    }
+    free(t);
+  }
+  free(k);
+  return NULL;
+}
+
+___TRAIT_UNUSED static const void *___trait_lookup(unsigned long long type_id,
+                                                   unsigned long long trait_id) {
+  struct trait_lookup_table *t = __atomic_load_n(&trait_lookup_table, __ATOMIC_ACQUIRE);
+  if (__builtin_expect(!t, 0)) {
+    struct trait_lookup_table *fresh = ___trait_lookup_build();
+    if (!fresh)
+      return NULL;
+    if (__atomic_compare_exchange_n(&trait_lookup_table, &t, fresh, 0,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+      t = fresh;
+    else
+      free(fresh);
+  }
+  unsigned long long key = ___trait_lookup_key(type_id, trait_id);
+  unsigned d = t->disp[___trait_lookup_bucket(key, t->bucket_bits)];
+  const struct trait_lookup_slot *s = &t->slot[___trait_lookup_index(key, d, t->bits)];
+  return s->type_id == type_id && s->trait_id == trait_id ? s->vtable : NULL;
+}
+
+// try_dyn(Trait, &obj) re-views any trait object as another trait its
+// concrete type implements (Go's x.(Show)):
+//   DynShow s = try_dyn(Show, &dyn_animal);
+//   if (s.vt) call(Show.show, &s);          // vt == NULL: not implemented
+// The concrete type is found from the source vtable alone: the registry's
+// vtables, sorted by address, map any pointer into one of them (including
+// a base vtable embedded in a derived one, as upcast() produces) to its type
+// id, and trait_lookup() does the rest.  The layout of vtables is unchanged.
+// Resolved (source vtable, trait) pairs, misses included, are kept in a
+// direct-mapped itab cache of TRAIT_ITAB_CACHE (256) entries, one array per
+// image.  An entry is written in place under a per-slot sequence count: a
+// reader that sees the count change, or odd, treats the slot as a miss.  A
+// miss overwrites its slot, so the pairs a loop keeps casting stay cached; a
+// writer that finds the slot being written skips the update.
+#define TRAIT_ITAB_CACHE 256
+
+struct trait_vtable_range {
+  const char *start, *end;
+  unsigned long long type_id;
+};
+
+struct trait_type_index {
+  unsigned n;
+  struct trait_vtable_range range[];
+};
+
+struct trait_itab {
+  unsigned long seq; // odd while the entry is being written
+  const void *src;   // NULL: empty
+  unsigned long long trait_id;
+  const void *dst;
+};
+
+__attribute__((__weak__)) struct trait_type_index *trait_type_index;
+__attribute__((__weak__)) struct trait_itab trait_itab_cache[TRAIT_ITAB_CACHE];
+
+// obj is evaluated once.
+#define try_dyn(T, obj)                                                            \
+  __extension__({                                                                  \
+    ___TRAIT_TYPEOF(obj) ___trait_obj = (obj);                                     \
+    (glue(Dyn, T)){___trait_obj->self,                                             \
+                   (const ___TRAIT_VTTYPE(T) *)___trait_try_dyn(                   \
+                       (const void *)___trait_obj->vt, trait_type_id(T))};         \
+  })
+
+___TRAIT_UNUSED static int ___trait_range_cmp(const void *a, const void *b) {
+  const char *x = ((const struct trait_vtable_range *)a)->start;
+  const char *y = ((const struct trait_vtable_range *)b)->start;
+  return x < y ? -1 : x > y;
+}
+
+// Type id of the impl whose vtable contains vt, or 0.
+___TRAIT_UNUSED static unsigned long long trait_type_id_of_vtable(const void *vt) {
+  struct trait_type_index *t = __atomic_load_n(&trait_type_index, __ATOMIC_ACQUIRE);
+  if (__builtin_expect(!t, 0)) {
+    unsigned n = (unsigned)(trait_registry_end() - trait_registry_begin());
+    struct trait_type_index *fresh = (struct trait_type_index *)malloc(
+        sizeof *fresh + n * sizeof(struct trait_vtable_range));
+    if (!fresh)
+      return 0;
+    fresh->n = n;
+    for (unsigned i = 0; i < n; i++) {
+      const struct trait_impl_meta *r = trait_registry_begin()[i];
+      fresh->range[i].start = (const char *)r->vtable;
+      fresh->range[i].end = (const char *)r->vtable + r->trait->vtable_size;
+      fresh->range[i].type_id = trait_type_id_of(r->type);
+    }
+    qsort(fresh->range, n, sizeof *fresh->range, ___trait_range_cmp);
+    if (__atomic_compare_exchange_n(&trait_type_index, &t, fresh, 0,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+      t = fresh;
+    else
+      free(fresh);
+  }
+  const char *p = (const char *)vt;
+  unsigned lo = 0, hi = t->n;
+  while (lo < hi) { // first range starting after p
+    unsigned mid = lo + (hi - lo) / 2;
+    if (t->range[mid].start <= p)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo && p < t->range[lo - 1].end ? t->range[lo - 1].type_id : 0;
+}
+
+___TRAIT_UNUSED static struct trait_itab *___trait_itab_slot(const void *vt,
+                                                             unsigned long long trait_id) {
+  unsigned long long k = ((unsigned long long)(size_t)vt ^ trait_id) * 0x9E3779B97F4A7C15ull;
+  return &trait_itab_cache[(k >> 32) & (TRAIT_ITAB_CACHE - 1)];
+}
+
+___TRAIT_UNUSED static const void *___trait_try_dyn(const void *vt,
+                                                    unsigned long long trait_id) {
+  if (!vt)
+    return NULL;
+  struct trait_itab *e = ___trait_itab_slot(vt, trait_id);
+  unsigned long seq = __atomic_load_n(&e->seq, __ATOMIC_ACQUIRE);
+  const void *src = __atomic_load_n(&e->src, __ATOMIC_RELAXED);
+  unsigned long long tid = __atomic_load_n(&e->trait_id, __ATOMIC_RELAXED);
+  const void *dst = __atomic_load_n(&e->dst, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_ACQUIRE);
+  if (!(seq & 1) && src == vt && tid == trait_id &&
+      __atomic_load_n(&e->seq, __ATOMIC_RELAXED) == seq)
+    return dst;
+  unsigned long long type_id = trait_type_id_of_vtable(vt);
+  dst = type_id ? ___trait_lookup(type_id, trait_id) : NULL;
+  seq = __atomic_load_n(&e->seq, __ATOMIC_RELAXED);
+  if (!(seq & 1) && __atomic_compare_exchange_n(&e->seq, &seq, seq + 1, 0,
+                                                __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&e->src, vt, __ATOMIC_RELAXED);
+    __atomic_store_n(&e->trait_id, trait_id, __ATOMIC_RELAXED);
+    __atomic_store_n(&e->dst, dst, __ATOMIC_RELAXED);
+    __atomic_store_n(&e->seq, seq + 2, __ATOMIC_RELEASE);
+  }
+  return dst;
+}
+
+#define ___TRAIT_META_IMPLS_DECL(T)                                                \
+  extern const struct trait_impl_meta *glue(__start_trait_impls_, T)[]             \
+      __attribute__((__weak__));                                                   \
+  extern const struct trait_impl_meta *glue(__stop_trait_impls_, T)[]              \
+      __attribute__((__weak__));
+
+#define ___TRAIT_META_IMPL()                                                       \
+  static const struct trait_impl_meta glue4(For, _, Impl, ___impl_meta) = {        \
+      ___TRAIT_STR(For), trait_meta(Impl), &___TRAIT_VTNAME(For, Impl),            \
+      sizeof(For)};                                                                \
+  static const struct trait_impl_meta *glue4(For, _, Impl, ___impl_ref)            \
+      __attribute__((__section__("trait_impls_" ___TRAIT_STR(Impl)), __used__)) =  \
+          &glue4(For, _, Impl, ___impl_meta);                                     \
+  static const struct trait_impl_meta *glue4(For, _, Impl, ___impl_reg)            \
+      __attribute__((__section__("trait_impls"), __used__)) =                      \
+          &glue4(For, _, Impl, ___impl_meta);
+#else
+#define ___TRAIT_META_IMPLS_DECL(T)
+#define ___TRAIT_META_IMPL()
+#endif
+
+// Both arrays end in a zero row so a trait without methods or bases still
+// has a valid initializer; the counts exclude it.
+#define ___TRAIT_META_DEF(T)                                                       \
+  ___TRAIT_META_IMPLS_DECL(T)                                                      \
+  ___TRAIT_UNUSED static const struct trait_method_meta glue(T, ___meta_methods)[] = { \
+      ___TRAIT_PASTE(T, Signature)((T, META)) {0, 0, 0, 0}};                        \
+  ___TRAIT_UNUSED static const struct trait_base_meta glue(T, ___meta_bases)[] = {  \
+      ___TRAIT_PASTE(T, Signature)((T, METABASE)) {0, 0, 0}};                       \
+  ___TRAIT_UNUSED static const struct trait_meta glue(T, ___meta) = {               \
+      ___TRAIT_STR(T), sizeof(___TRAIT_VTTYPE(T)), glue(T, ___meta_methods),        \
+      sizeof glue(T, ___meta_methods) / sizeof *glue(T, ___meta_methods) - 1,       \
+      glue(T, ___meta_bases),                                                       \
+      sizeof glue(T, ___meta_bases) / sizeof *glue(T, ___meta_bases) - 1};
+
+// Own methods first, then each base depth-first in declaration order.
+// Returns NULL if m has no method called name.
+___TRAIT_UNUSED static trait_meta_fn trait_meta_lookup(const struct trait_meta *m,
+                                                       const void *vt,
+                                                       const char *name) {
+  const char *base = (const char *)vt;
+  for (unsigned i = 0; i < m->n_methods; i++)
+    if (___trait_meta_streq(m->methods[i].name, name))
+      return *(const trait_meta_fn *)(const void *)(base + m->methods[i].offset);
+  for (unsigned i = 0; i < m->n_bases; i++) {
+    const void *bvt = base + m->bases[i].offset;
+    if (m->bases[i].shared)
+      bvt = *(const void *const *)bvt;
+    trait_meta_fn fn = trait_meta_lookup(m->bases[i].base, bvt, name);
+    if (fn)
+      return fn;
+  }
+  return NULL;
+}
+
 // -----------------------------------------------------------------------------
 // Actions: MLIST (emit comma-separated method tuples for SD iteration)
 //
@@ -1126,10 +1953,11 @@ ___TRAIT_UNUSED static ___TRAIT_CONSTEXPR glue(Trait, ___sel_t)
 // to the embedded base field (self->vt->Base.method) instead of a top-level
 // vtable field.
 //
-// Blue-paint note: a replayed base's OWN extends is deferred and absorbed by
-// the MSEL dummy argument, so replay is intentionally limited to one hop.
-// Transitive base methods (call(GrandBase.method, &dyn_derived)) therefore
-// are not registered — a hard preprocessor limit, not a design choice.
+// The replay is deferred (___TRAIT_DEFER, expanded by the ___TRAIT_EVAL in
+// ___TRAIT_DYNSD_LIST) so the base's own extends is not blue-painted: it
+// expands under DMLISTV, which is a no-op.  Replay is therefore one hop —
+// transitive base methods (call(GrandBase.method, &dyn_derived)) are not
+// registered; upcast(GrandBase, &dyn_derived) reaches them instead.
 // -----------------------------------------------------------------------------
 #define ___TRAIT_ACT_DMLIST_REQUIRE_0(Type, Ret, Name, ...)                       \
   , (Type, 0, Ret, Name, ##__VA_ARGS__)
@@ -1149,10 +1977,59 @@ ___TRAIT_UNUSED static ___TRAIT_CONSTEXPR glue(Trait, ___sel_t)
 #define ___TRAIT_ACT_DMLISTV_DEFAULT_1(Type, Ret, Name, ...)                      \
   , (Type, 1, Ret, ___TRAIT_VT, Name, ##__VA_ARGS__)
 
+// DMLISTP: same as DMLISTV for a base embedded by pointer (extends_shared);
+// the ___TRAIT_VTP marker makes the wrapper use self->vt->Base->method.
+#define ___TRAIT_ACT_DMLISTP_REQUIRE_0(Type, Ret, Name, ...)                      \
+  , (Type, 0, Ret, ___TRAIT_VTP, Name, ##__VA_ARGS__)
+#define ___TRAIT_ACT_DMLISTP_REQUIRE_1(Type, Ret, Name, ...)                      \
+  , (Type, 1, Ret, ___TRAIT_VTP, Name, ##__VA_ARGS__)
+#define ___TRAIT_ACT_DMLISTP_DEFAULT_0(Type, Ret, Name, ...)                      \
+  , (Type, 0, Ret, ___TRAIT_VTP, Name, ##__VA_ARGS__)
+#define ___TRAIT_ACT_DMLISTP_DEFAULT_1(Type, Ret, Name, ...)                      \
+  , (Type, 1, Ret, ___TRAIT_VTP, Name, ##__VA_ARGS__)
+
 #define ___TRAIT_EXTENDS_DMLIST(Base, SelfSpec)                                   \
-  ___TRAIT_PASTE(Base, Signature)((Base, DMLISTV))
-#define ___TRAIT_EXTENDS_DMLISTV(Base, SelfSpec)                                  \
-  ___TRAIT_PASTE(Base, Signature)((Base, DMLISTV))
+  ___TRAIT_DEFER(___TRAIT_DM_NEXT)()(Base)
+#define ___TRAIT_EXTENDS_DMLISTV(Base, SelfSpec) /* no-op: one hop */
+#define ___TRAIT_EXTENDS_DMLISTP(Base, SelfSpec) /* no-op: one hop */
+#define ___TRAIT_DM_NEXT() ___TRAIT_DM_REPLAY
+#define ___TRAIT_DM_REPLAY(Base) ___TRAIT_PASTE(Base, Signature)((Base, DMLISTV))
+
+// -----------------------------------------------------------------------------
+// Actions: UPLIST (transitive supertrait list for upcast)
+//
+// Methods emit nothing; each extends emits , (___TRAIT_UP, Base, Path) where
+// Path is the member access from the trait object to the embedded base
+// vtable, e.g. vt[0].Pet.Animal.  The Type slot of the SelfSpec carries the
+// path accumulated so far (starting at ___TRAIT_DYNSD_VT[0]).
+//
+// Unlike DMLIST replay, the recursion into the base's own signature is
+// deferred (___TRAIT_DEFER) so that its extends is not blue-painted; each
+// ___TRAIT_EVAL rescan unrolls one more level of the hierarchy.
+// -----------------------------------------------------------------------------
+#define ___TRAIT_ACT_UPLIST_REQUIRE_0(Type, Ret, Name, ...)
+#define ___TRAIT_ACT_UPLIST_REQUIRE_1(Type, Ret, Name, ...)
+#define ___TRAIT_ACT_UPLIST_DEFAULT_0(Type, Ret, Name, ...)
+#define ___TRAIT_ACT_UPLIST_DEFAULT_1(Type, Ret, Name, ...)
+
+#define ___TRAIT_EMPTY()
+#define ___TRAIT_DEFER(m) m ___TRAIT_EMPTY()
+#define ___TRAIT_EVAL_1(...) __VA_ARGS__
+#define ___TRAIT_EVAL_4(...)                                                      \
+  ___TRAIT_EVAL_1(___TRAIT_EVAL_1(___TRAIT_EVAL_1(___TRAIT_EVAL_1(__VA_ARGS__))))
+#define ___TRAIT_EVAL(...) ___TRAIT_EVAL_4(___TRAIT_EVAL_4(__VA_ARGS__))
+
+#define ___TRAIT_EXTENDS_UPLIST(Base, SelfSpec)                                   \
+  , (___TRAIT_UP, Base, ___TRAIT_SPEC_TYPE(SelfSpec).Base)                        \
+  ___TRAIT_DEFER(___TRAIT_UP_NEXT)()(Base, ___TRAIT_SPEC_TYPE(SelfSpec).Base)
+#define ___TRAIT_UP_NEXT() ___TRAIT_UP_RECURSE
+#define ___TRAIT_UP_RECURSE(Base, Path)                                           \
+  ___TRAIT_PASTE(Base, Signature)((Path, UPLIST))
+
+// All supertraits of TraitImpl, depth-first in declaration order (hierarchies
+// up to 8 levels deep).
+#define ___TRAIT_UP_LIST(TraitImpl)                                               \
+  ___TRAIT_EVAL(___TRAIT_PASTE(TraitImpl, Signature)((___TRAIT_DYNSD_VT[0], UPLIST)))
 
 // -----------------------------------------------------------------------------
 // Actions: BIND (vtable initializer)
@@ -1460,7 +2337,7 @@ ___TRAIT_UNUSED static ___TRAIT_CONSTEXPR glue(Trait, ___sel_t)
 #define ___TRAIT_ACT_SDFL_DEFAULT_1(Type, Ret, Name, ...)                        \
   ___TRAIT_IF_OVR(For, Type, Name, ,                                                   \
     glue5(___TRAIT_SDFL_, 0, _, 1, ___TRAIT_NARG(__VA_ARGS__)),                    \
-    Type, Ret, Name, ##__VA_ARGS__))
+    Type, Ret, Name, ##__VA_ARGS__)
 
 // -----------------------------------------------------------------------------
 // The `trait(...)` declaration expands the signature to emit:
@@ -1471,12 +2348,18 @@ ___TRAIT_UNUSED static ___TRAIT_CONSTEXPR glue(Trait, ___sel_t)
 // -----------------------------------------------------------------------------
 #define trait(NameSignature)                                                       \
   typedef struct {                                                                 \
-    ___TRAIT_PASTE(NameSignature, Signature)((NameSignature, FN))                     \
+    ___TRAIT_VTABLE_FIELDS(NameSignature)                                          \
   } NameSignature##_vtable;                                                        \
   typedef struct {                                                                 \
     void *self;                                                                    \
     const NameSignature##_vtable *vt;                                              \
   } Dyn##NameSignature;                                                            \
+  enum {                                                                           \
+    NameSignature##___methods =                                                    \
+        0 ___TRAIT_PASTE(NameSignature, Signature)((NameSignature, MCOUNT)),       \
+    NameSignature##___dyn_slots = 0                                                \
+  };                                                                               \
+  ___TRAIT_META_DEF(NameSignature)                                                 \
   ___TRAIT_PASTE(NameSignature, Signature)((NameSignature, FWD))                     \
   ___TRAIT_PASTE(NameSignature, Signature)((NameSignature, STAG))                    \
   typedef struct {                                                                 \
@@ -1513,18 +2396,73 @@ ___TRAIT_UNUSED static ___TRAIT_CONSTEXPR glue(Trait, ___sel_t)
   glue(___TRAIT_EXTENDS_, ___TRAIT_GET_ACTION(SelfSpec))(Base, SelfSpec)
 #define ___TRAIT_EXTENDS_FN(Base, SelfSpec)                                        \
   Base##_vtable Base;
+#define ___TRAIT_EXTENDS_FNHOT(Base, SelfSpec) /* no-op: not annotated hot */
+#define ___TRAIT_EXTENDS_FNCOLD(Base, SelfSpec) /* no-op: not annotated cold */
+#define ___TRAIT_EXTENDS_FNSKIP(Base, SelfSpec) /* no-op: emitted in another pass */
+#define ___TRAIT_EXTENDS_ALIGN(Base, SelfSpec) /* no-op: not annotated hot */
+#define ___TRAIT_EXTENDS_ALIGNHOT(Base, SelfSpec) ___TRAIT_ALIGN_HOT
 #define ___TRAIT_EXTENDS_FWD(Base, SelfSpec) /* no-op: no per-method FWD actions */
 #define ___TRAIT_EXTENDS_STAG(Base, SelfSpec) /* no-op: selector tags already exist */
 #define ___TRAIT_EXTENDS_SSEL(Base, SelfSpec) /* no-op: selector fields already exist */
+#define ___TRAIT_EXTENDS_MCOUNT(Base, SelfSpec) + trait_methods(Base)
+#define ___TRAIT_EXTENDS_META(Base, SelfSpec) /* no-op: reached through METABASE */
+#define ___TRAIT_EXTENDS_METABASE(Base, SelfSpec)                                  \
+  {trait_meta(Base), offsetof(___TRAIT_VTTYPE(___TRAIT_SPEC_TYPE(SelfSpec)), Base), 0},
 #define ___TRAIT_EXTENDS_DFL(Base, SelfSpec) /* no-op: base DFL wrappers already exist */
 #define ___TRAIT_EXTENDS_SDFL(Base, SelfSpec) /* no-op: base SDFL wrappers already exist */
 #define ___TRAIT_EXTENDS_BIND(Base, SelfSpec)                                      \
   .Base = ___TRAIT_VTNAME(For, Base),
 #define ___TRAIT_EXTENDS_FWDDECL(Base, SelfSpec) /* no-op: BIND uses the base vtable */
 #define ___TRAIT_EXTENDS_ENFORCE(Base, SelfSpec)                                 \
-  ___TRAIT_UNUSED static void *const                                              \
-      glue5(___trait_enforce, _, For, _, Base) =                                  \
-          (void *)&glue4(For, _, Base, _vtable);
+  typedef char glue7(___trait_enforce, _, For, _, Impl, _, Base)                   \
+      [sizeof(glue4(For, _, Base, _vtable))];
+
+// -----------------------------------------------------------------------------
+// `extends_shared(Base, Self)` — same contract as extends, but the derived
+// vtable holds `const Base##_vtable *Base;` pointing at the implementing
+// type's single For##_Base##_vtable instead of a by-value copy.  A type
+// implementing N traits that extend the same wide base then stores the base
+// table once (N pointers instead of N copies), at the cost of one extra load
+// per base-method call through the derived object:
+//   DynPet dp = dyn(Pet, &dog);
+//   dp.vt->Animal->get_snacks(dp.self);
+// call(), upcast() and DMLIST replay follow the pointer automatically (the
+// replayed tuples carry ___TRAIT_VTP instead of ___TRAIT_VT).  The layout is
+// chosen per base: a trait may mix extends and extends_shared.
+// -----------------------------------------------------------------------------
+#define extends_shared(Base, SelfSpec)                                         \
+  glue(___TRAIT_EXTENDS_SHARED_, ___TRAIT_GET_ACTION(SelfSpec))(Base, SelfSpec)
+#define ___TRAIT_EXTENDS_SHARED_FN(Base, SelfSpec)                                 \
+  const Base##_vtable *Base;
+#define ___TRAIT_EXTENDS_SHARED_BIND(Base, SelfSpec)                               \
+  .Base = &___TRAIT_VTNAME(For, Base),
+#define ___TRAIT_EXTENDS_SHARED_DMLIST(Base, SelfSpec)                             \
+  ___TRAIT_DEFER(___TRAIT_DM_NEXT_SHARED)()(Base)
+#define ___TRAIT_DM_NEXT_SHARED() ___TRAIT_DM_REPLAY_SHARED
+#define ___TRAIT_DM_REPLAY_SHARED(Base)                                            \
+  ___TRAIT_PASTE(Base, Signature)((Base, DMLISTP))
+#define ___TRAIT_EXTENDS_SHARED_UPLIST(Base, SelfSpec)                             \
+  , (___TRAIT_UP, Base, ___TRAIT_SPEC_TYPE(SelfSpec).Base[0])                     \
+  ___TRAIT_DEFER(___TRAIT_UP_NEXT)()(Base, ___TRAIT_SPEC_TYPE(SelfSpec).Base[0])
+#define ___TRAIT_EXTENDS_SHARED_FNHOT(Base, SelfSpec) ___TRAIT_EXTENDS_FNHOT(Base, SelfSpec)
+#define ___TRAIT_EXTENDS_SHARED_FNCOLD(Base, SelfSpec) ___TRAIT_EXTENDS_FNCOLD(Base, SelfSpec)
+#define ___TRAIT_EXTENDS_SHARED_FNSKIP(Base, SelfSpec) ___TRAIT_EXTENDS_FNSKIP(Base, SelfSpec)
+#define ___TRAIT_EXTENDS_SHARED_ALIGN(Base, SelfSpec) ___TRAIT_EXTENDS_ALIGN(Base, SelfSpec)
+#define ___TRAIT_EXTENDS_SHARED_ALIGNHOT(Base, SelfSpec) ___TRAIT_EXTENDS_ALIGNHOT(Base, SelfSpec)
+#define ___TRAIT_EXTENDS_SHARED_FWD(Base, SelfSpec) ___TRAIT_EXTENDS_FWD(Base, SelfSpec)
+#define ___TRAIT_EXTENDS_SHARED_STAG(Base, SelfSpec) ___TRAIT_EXTENDS_STAG(Base, SelfSpec)
+#define ___TRAIT_EXTENDS_SHARED_SSEL(Base, SelfSpec) ___TRAIT_EXTENDS_SSEL(Base, SelfSpec)
+#define ___TRAIT_EXTENDS_SHARED_MCOUNT(Base, SelfSpec) ___TRAIT_EXTENDS_MCOUNT(Base, SelfSpec)
+#define ___TRAIT_EXTENDS_SHARED_META(Base, SelfSpec) ___TRAIT_EXTENDS_META(Base, SelfSpec)
+#define ___TRAIT_EXTENDS_SHARED_METABASE(Base, SelfSpec)                           \
+  {trait_meta(Base), offsetof(___TRAIT_VTTYPE(___TRAIT_SPEC_TYPE(SelfSpec)), Base), 1},
+#define ___TRAIT_EXTENDS_SHARED_DFL(Base, SelfSpec) ___TRAIT_EXTENDS_DFL(Base, SelfSpec)
+#define ___TRAIT_EXTENDS_SHARED_SDFL(Base, SelfSpec) ___TRAIT_EXTENDS_SDFL(Base, SelfSpec)
+#define ___TRAIT_EXTENDS_SHARED_FWDDECL(Base, SelfSpec) ___TRAIT_EXTENDS_FWDDECL(Base, SelfSpec)
+#define ___TRAIT_EXTENDS_SHARED_ENFORCE(Base, SelfSpec) ___TRAIT_EXTENDS_ENFORCE(Base, SelfSpec)
+#define ___TRAIT_EXTENDS_SHARED_MLIST(Base, SelfSpec) /* no-op */
+#define ___TRAIT_EXTENDS_SHARED_DMLISTV(Base, SelfSpec) /* no-op: one hop */
+#define ___TRAIT_EXTENDS_SHARED_DMLISTP(Base, SelfSpec) /* no-op: one hop */
 
 // -----------------------------------------------------------------------------
 // `def(...)` defines the implementation function body.
@@ -1580,8 +2518,8 @@ ___TRAIT_UNUSED static ___TRAIT_CONSTEXPR glue(Trait, ___sel_t)
   ___TRAIT_PASTE(Impl, Signature)((Impl, SDFL))
 
 #define ___TRAIT_IMPL()                                                                 \
-  ___TRAIT_UNUSED static const ___TRAIT_VTTYPE(Impl)                          \
-      ___TRAIT_VTNAME(For, Impl) = {___TRAIT_PASTE(Impl, Signature)((Impl, BIND))};    \
+  ___TRAIT_UNUSED static ___TRAIT_PASTE(Impl, Signature)((Impl, ALIGN))          \
+      const ___TRAIT_VTTYPE(Impl) ___TRAIT_VTNAME(For, Impl) = {___TRAIT_PASTE(Impl, Signature)((Impl, BIND))};    \
   ___TRAIT_UNUSED static inline glue(Dyn, Impl)                                 \
       glue3(For, _as_, Impl)(For * obj) {                                      \
     return (glue(Dyn, Impl)){.self = obj, .vt = &___TRAIT_VTNAME(For, Impl)};    \
@@ -1601,6 +2539,9 @@ ___TRAIT_UNUSED static ___TRAIT_CONSTEXPR glue(Trait, ___sel_t)
   typedef void (*glue8(___trait_tt_pair_, ___TRAIT_TT_C6, ___TRAIT_TT_C5,         \
                       ___TRAIT_TT_C4, ___TRAIT_TT_C3, ___TRAIT_TT_C2,             \
                       ___TRAIT_TT_C1, _p))(glue(Impl, ___sel_t), For);            \
+  ___TRAIT_SYMMAP(glue7(___trait_tt_fn_, ___TRAIT_TT_C6, ___TRAIT_TT_C5,          \
+                        ___TRAIT_TT_C4, ___TRAIT_TT_C3, ___TRAIT_TT_C2,            \
+                        ___TRAIT_TT_C1), For, Impl, dyn, tt)                        \
   ___TRAIT_UNUSED static inline glue(Dyn, Impl)                                    \
       glue7(___trait_tt_fn_, ___TRAIT_TT_C6, ___TRAIT_TT_C5, ___TRAIT_TT_C4,      \
             ___TRAIT_TT_C3, ___TRAIT_TT_C2, ___TRAIT_TT_C1)(For * ptr) {          \
@@ -1628,6 +2569,17 @@ extern struct ERROR_type_not_impl_for_this_trait ERROR_type_not_impl_for_this_tr
       default: ERROR_type_not_impl_for_this_trait                                  \
   )(ptr)
 
+// -----------------------------------------------------------------------------
+// upcast(Base, &dyn_derived) → DynBase
+//   Re-views a trait object as any (transitive) supertrait: self is kept and
+//   vt points into the base vtable embedded in the derived one, so this is a
+//   single pointer add — no concrete type or dyn() registry lookup involved.
+//   Dispatches through call(): every dynamic trait registers one SD entry per
+//   supertrait at definition time.  A base reachable along several extends
+//   paths (diamond) resolves to the first one in declaration order.
+// -----------------------------------------------------------------------------
+#define upcast(Base, obj) call((glue(Base, ___up_t)(*)[1])0, obj)
+
 #define ___TRAIT_FROM_TRAIT_IMPL(Type, Trait, obj) Type##_from_##Trait(obj)
 #define from_trait(Type, Trait, obj) ___TRAIT_FROM_TRAIT_IMPL(Type, Trait, obj)
 
@@ -1636,10 +2588,73 @@ extern struct ERROR_type_not_impl_for_this_trait ERROR_type_not_impl_for_this_tr
 #define ___TRAIT_NEW_TRAIT_IMPL(Type, Trait, ...) Type##_as_##Trait(&(Type)__VA_ARGS__)
 #define new_trait(Type, Trait, ...) ___TRAIT_NEW_TRAIT_IMPL(Type, Trait, __VA_ARGS__)
 
+// -----------------------------------------------------------------------------
+// Multi-trait objects: Dyn2(A, B), Dyn3(A, B, C), Dyn4(A, B, C, D)
+//
+// A single fat pointer carrying several vtables for the same self:
+//   typedef struct {
+//     void *self;
+//     const Animal_vtable *Animal;
+//     const Show_vtable *Show;
+//   } Dyn2_Animal_Show;
+// Declared with `#define Multi Animal, Show` + `#include "trait.h"`.
+// dyn2(Animal, Show, ptr) fills each vtable field through the TT registry.
+// The vtables are picked by dyn() on a null pointer of ptr's type (typeof
+// does not evaluate its operand), so ptr itself is evaluated once, in .self.
+// DynMulti(...) names the same type for any supported arity.
+//
+// Member traits must not extend one another: both would register the shared
+// base methods for the multi type, duplicating _Generic pair types.
+// -----------------------------------------------------------------------------
+#define ___TRAIT_MULTI_NAME_2(A, B) glue4(Dyn2_, A, _, B)
+#define ___TRAIT_MULTI_NAME_3(A, B, C) glue6(Dyn3_, A, _, B, _, C)
+#define ___TRAIT_MULTI_NAME_4(A, B, C, D) glue8(Dyn4_, A, _, B, _, C, _, D)
+// Member count of the Multi list.  The extra hop expands Multi before NARG's
+// `##__VA_ARGS__` would paste it unexpanded.
+#define ___TRAIT_MULTI_COUNT(...) ___TRAIT_NARG(__VA_ARGS__)
+#define ___TRAIT_MULTI_NAME(...)                                                   \
+  glue(___TRAIT_MULTI_NAME_, ___TRAIT_NARG(__VA_ARGS__))(__VA_ARGS__)
+
+#define ___TRAIT_MULTI_FIELD(T) const glue(T, _vtable) *T;
+#define ___TRAIT_MULTI_FIELDS_2(A, B)                                              \
+  ___TRAIT_MULTI_FIELD(A) ___TRAIT_MULTI_FIELD(B)
+#define ___TRAIT_MULTI_FIELDS_3(A, B, C)                                           \
+  ___TRAIT_MULTI_FIELDS_2(A, B) ___TRAIT_MULTI_FIELD(C)
+#define ___TRAIT_MULTI_FIELDS_4(A, B, C, D)                                        \
+  ___TRAIT_MULTI_FIELDS_3(A, B, C) ___TRAIT_MULTI_FIELD(D)
+#define ___TRAIT_MULTI_STRUCT(...)                                                 \
+  typedef struct {                                                                 \
+    void *self;                                                                    \
+    glue(___TRAIT_MULTI_FIELDS_, ___TRAIT_NARG(__VA_ARGS__))(__VA_ARGS__)          \
+  } ___TRAIT_MULTI_NAME(__VA_ARGS__);
+
+// K-th member of the Multi list.  The trailing ~ keeps MSEL's variadic tail
+// non-empty for the last member (ISO C99 requires at least one argument).
+#define ___TRAIT_MULTI_AT(K, ...)                                                  \
+  ___TRAIT_SD_APPLY(glue(___TRAIT_MSEL_, K), 0, __VA_ARGS__, ~)
+
+#define Dyn2(A, B) ___TRAIT_MULTI_NAME_2(A, B)
+#define Dyn3(A, B, C) ___TRAIT_MULTI_NAME_3(A, B, C)
+#define Dyn4(A, B, C, D) ___TRAIT_MULTI_NAME_4(A, B, C, D)
+#define DynMulti(...) ___TRAIT_MULTI_NAME(__VA_ARGS__)
+
+#define ___TRAIT_MULTI_VT(T, ptr) dyn(T, (___TRAIT_TYPEOF(ptr))0).vt
+#define dyn2(A, B, ptr)                                                            \
+  ((Dyn2(A, B)){.self = (ptr), .A = ___TRAIT_MULTI_VT(A, ptr),                     \
+                .B = ___TRAIT_MULTI_VT(B, ptr)})
+#define dyn3(A, B, C, ptr)                                                         \
+  ((Dyn3(A, B, C)){.self = (ptr), .A = ___TRAIT_MULTI_VT(A, ptr),                  \
+                   .B = ___TRAIT_MULTI_VT(B, ptr), .C = ___TRAIT_MULTI_VT(C, ptr)})
+#define dyn4(A, B, C, D, ptr)                                                      \
+  ((Dyn4(A, B, C, D)){.self = (ptr), .A = ___TRAIT_MULTI_VT(A, ptr),               \
+                      .B = ___TRAIT_MULTI_VT(B, ptr), .C = ___TRAIT_MULTI_VT(C, ptr), \
+                      .D = ___TRAIT_MULTI_VT(D, ptr)})
+
 // ── ENFORCE action: impl-site enforcement of extends ─────────────────────────
-// For each extends(Base), emits a static reference to For##_Base##_vtable.
-// If the type hasn't implemented the base trait, the symbol is undefined
-// → linker error at impl site.
+// For each extends(Base), emits a typedef sized by For##_Base##_vtable.
+// If the type hasn't implemented the base trait, the identifier is undeclared
+// → compile error at impl site.  Only a type is emitted, so the check keeps
+// no vtable alive.
 // require/default methods are no-ops for ENFORCE.
 #define ___TRAIT_ACT_ENFORCE_REQUIRE_0(Type, Ret, Name, ...) /* no-op */
 #define ___TRAIT_ACT_ENFORCE_REQUIRE_1(Type, Ret, Name, ...) /* no-op */
@@ -1651,6 +2666,11 @@ extern struct ERROR_type_not_impl_for_this_trait ERROR_type_not_impl_for_this_tr
 // impl function so that SD entries (which call these functions) can be emitted
 // before the def() bodies.
 // _0 suffix = mutable (For *), _1 suffix = immutable/const (const For *).
+//
+// Default slots are declared extern too: Override_<For>_<Trait>_<Method> is
+// usually defined between the two includes, next to its def(), so whether a
+// slot is overridden is not known yet.  An override thus keeps external
+// linkage, and a DFL wrapper emitted by the second include is external.
 #define ___TRAIT_ACT_FWDDECL_REQUIRE_0(Type, Ret, Name, ...)                     \
   extern Ret glue5(For, _, Type, _, Name)(                                        \
       For *, ##__VA_ARGS__);
@@ -1683,7 +2703,7 @@ extern struct ERROR_type_not_impl_for_this_trait ERROR_type_not_impl_for_this_tr
 //
 // ___TRAIT_MSEL_K(dummy, a0, a1, ..., aK, ...) → aK
 // The `dummy` argument absorbs the leading comma from MLIST expansion.
-// Supports up to 16 method slots (MSEL_0..MSEL_15).
+// Supports up to 32 slots (MSEL_0..MSEL_31).
 // -----------------------------------------------------------------------------
 #define ___TRAIT_MSEL_0(d, a, ...) a
 #define ___TRAIT_MSEL_1(d, a, b, ...) b
@@ -1701,23 +2721,63 @@ extern struct ERROR_type_not_impl_for_this_trait ERROR_type_not_impl_for_this_tr
 #define ___TRAIT_MSEL_13(d, a, b, c, e, f, g, h, i, j, k, l, m, n, o, ...) o
 #define ___TRAIT_MSEL_14(d, a, b, c, e, f, g, h, i, j, k, l, m, n, o, p, ...) p
 #define ___TRAIT_MSEL_15(d, a, b, c, e, f, g, h, i, j, k, l, m, n, o, p, q, ...) q
+// MSEL_16..MSEL_31 (DynSD lists only) drop one leading element and defer.
+#define ___TRAIT_MSEL_16(d, a, ...) ___TRAIT_MSEL_15(d, __VA_ARGS__)
+#define ___TRAIT_MSEL_17(d, a, ...) ___TRAIT_MSEL_16(d, __VA_ARGS__)
+#define ___TRAIT_MSEL_18(d, a, ...) ___TRAIT_MSEL_17(d, __VA_ARGS__)
+#define ___TRAIT_MSEL_19(d, a, ...) ___TRAIT_MSEL_18(d, __VA_ARGS__)
+#define ___TRAIT_MSEL_20(d, a, ...) ___TRAIT_MSEL_19(d, __VA_ARGS__)
+#define ___TRAIT_MSEL_21(d, a, ...) ___TRAIT_MSEL_20(d, __VA_ARGS__)
+#define ___TRAIT_MSEL_22(d, a, ...) ___TRAIT_MSEL_21(d, __VA_ARGS__)
+#define ___TRAIT_MSEL_23(d, a, ...) ___TRAIT_MSEL_22(d, __VA_ARGS__)
+#define ___TRAIT_MSEL_24(d, a, ...) ___TRAIT_MSEL_23(d, __VA_ARGS__)
+#define ___TRAIT_MSEL_25(d, a, ...) ___TRAIT_MSEL_24(d, __VA_ARGS__)
+#define ___TRAIT_MSEL_26(d, a, ...) ___TRAIT_MSEL_25(d, __VA_ARGS__)
+#define ___TRAIT_MSEL_27(d, a, ...) ___TRAIT_MSEL_26(d, __VA_ARGS__)
+#define ___TRAIT_MSEL_28(d, a, ...) ___TRAIT_MSEL_27(d, __VA_ARGS__)
+#define ___TRAIT_MSEL_29(d, a, ...) ___TRAIT_MSEL_28(d, __VA_ARGS__)
+#define ___TRAIT_MSEL_30(d, a, ...) ___TRAIT_MSEL_29(d, __VA_ARGS__)
+#define ___TRAIT_MSEL_31(d, a, ...) ___TRAIT_MSEL_30(d, __VA_ARGS__)
 
 // Relay macro: forces expansion of args before argument splitting.
 // This is critical because MLIST expansion produces commas that must be
 // visible as argument separators when MSEL_K identifies its arguments.
 #define ___TRAIT_SD_APPLY(M, ...) M(__VA_ARGS__)
 
-// Select the Kth method tuple from a trait's MLIST expansion.
-// Returns a parenthesized tuple: (NameSignature, ConstFlag, Ret, Name, ExtraArgs...)
+// Select the Kth tuple of an impl's SD slots: the impl marker
+// (___TRAIT_IMPLS_MARK, see implements()), then one per method from the
+// trait's MLIST expansion, (NameSignature, ConstFlag, Ret, Name, ExtraArgs...),
+// then the trait's generics.
 // Sentinel tuples (_STOP) are appended to safely handle out-of-range K.
 #define ___TRAIT_SD_SELECT(K, TraitImpl)                                         \
   ___TRAIT_SD_APPLY(glue(___TRAIT_MSEL_, K),                                       \
-      0 ___TRAIT_PASTE(TraitImpl, Signature)((TraitImpl, MLIST))                   \
+      0 , (___TRAIT_IMPLS_MARK)                                                    \
+      ___TRAIT_PASTE(TraitImpl, Signature)((TraitImpl, MLIST))                     \
+      ___TRAIT_GENERIC_LIST(TraitImpl)                                             \
+      , (_STOP) , (_STOP) , (_STOP) , (_STOP)                                  \
+      , (_STOP) , (_STOP) , (_STOP) , (_STOP)                                  \
+      , (_STOP) , (_STOP) , (_STOP) , (_STOP)                                  \
+      , (_STOP) , (_STOP) , (_STOP) , (_STOP)                                  \
       , (_STOP) , (_STOP) , (_STOP) , (_STOP)                                  \
       , (_STOP) , (_STOP) , (_STOP) , (_STOP)                                  \
       , (_STOP) , (_STOP) , (_STOP) , (_STOP)                                  \
       , (_STOP) , (_STOP) , (_STOP) , (_STOP))
 
+// -----------------------------------------------------------------------------
+// Generic algorithms: <Trait>Generics(X) lists X(name) per generic, and
+// nameGeneric(T) defines name_T.  Each generic follows the methods in the SD
+// loop as (___TRAIT_GENERIC, name); see ___TRAIT_GENERIC_EMIT.  Nothing is
+// appended when <Trait>Generics is not defined.
+// -----------------------------------------------------------------------------
+#define ___TRAIT_GENERIC_PROBE(G) ~, 1,
+#define ___TRAIT_GENERIC_TUPLE(G) , (___TRAIT_GENERIC, G)
+#define ___TRAIT_GENERIC_LIST_0(TraitImpl)
+#define ___TRAIT_GENERIC_LIST_1(TraitImpl)                                         \
+  ___TRAIT_PASTE(TraitImpl, Generics)(___TRAIT_GENERIC_TUPLE)
+#define ___TRAIT_GENERIC_LIST(TraitImpl)                                           \
+  glue(___TRAIT_GENERIC_LIST_,                                                     \
+       ___TRAIT_CHECK(___TRAIT_PASTE(TraitImpl, Generics)(___TRAIT_GENERIC_PROBE)))(TraitImpl)
+
 // -----------------------------------------------------------------------------
 // Sentinel detection for the self-include loop.
 // ___TRAIT_SD_IS_STOP(K, TraitImpl) → 1 if method K is past the last method.
@@ -1736,14 +2796,24 @@ extern struct ERROR_type_not_impl_for_this_trait ERROR_type_not_impl_for_this_tr
 // signature is expanded under the DMLIST action so extends replays the direct
 // base's signature (base methods are registered for the Dyn pair).  Replayed
 // tuples carry the ___TRAIT_VT marker at position 4.
+//
+// After the methods come the upcast targets, (___TRAIT_UP, Base, Path), one
+// per transitive supertrait (see UPLIST).
 // -----------------------------------------------------------------------------
+#define ___TRAIT_DYNSD_LIST(TraitImpl)                                             \
+  0 ___TRAIT_EVAL(___TRAIT_PASTE(TraitImpl, Signature)((TraitImpl, DMLIST)))       \
+  ___TRAIT_UP_LIST(TraitImpl)                                                      \
+  , (_STOP) , (_STOP) , (_STOP) , (_STOP)                                      \
+  , (_STOP) , (_STOP) , (_STOP) , (_STOP)                                      \
+  , (_STOP) , (_STOP) , (_STOP) , (_STOP)                                      \
+  , (_STOP) , (_STOP) , (_STOP) , (_STOP)                                      \
+  , (_STOP) , (_STOP) , (_STOP) , (_STOP)                                      \
+  , (_STOP) , (_STOP) , (_STOP) , (_STOP)                                      \
+  , (_STOP) , (_STOP) , (_STOP) , (_STOP)                                      \
+  , (_STOP) , (_STOP) , (_STOP) , (_STOP)
+
 #define ___TRAIT_DYNSD_SELECT(K, TraitImpl)                                       \
-  ___TRAIT_SD_APPLY(glue(___TRAIT_MSEL_, K),                                       \
-      0 ___TRAIT_PASTE(TraitImpl, Signature)((TraitImpl, DMLIST))                  \
-      , (_STOP) , (_STOP) , (_STOP) , (_STOP)                                  \
-      , (_STOP) , (_STOP) , (_STOP) , (_STOP)                                  \
-      , (_STOP) , (_STOP) , (_STOP) , (_STOP)                                  \
-      , (_STOP) , (_STOP) , (_STOP) , (_STOP))
+  ___TRAIT_SD_APPLY(glue(___TRAIT_MSEL_, K), ___TRAIT_DYNSD_LIST(TraitImpl))
 
 #define ___TRAIT_SD_IS_STOP_DYN(K, TraitImpl)                                     \
   ___TRAIT_CHECK(glue(___TRAIT_SD_STOP_CHECK_,                                     \
@@ -1760,15 +2830,347 @@ extern struct ERROR_type_not_impl_for_this_trait ERROR_type_not_impl_for_this_tr
 // Uses For (concrete type) and Impl (trait name) which are still defined
 // during the SD self-include loop.
 // -----------------------------------------------------------------------------
-#define ___TRAIT_SD_EMIT(tuple) ___TRAIT_SD_EMIT_I tuple
+#define ___TRAIT_SD_EMIT(tuple)                                                    \
+  glue3(___TRAIT_SD_EMIT_, ___TRAIT_GENERIC_IS(tuple), ___TRAIT_IMPLS_MARK_IS(tuple)) tuple
+#define ___TRAIT_SD_EMIT_00 ___TRAIT_SD_EMIT_I
+#define ___TRAIT_SD_EMIT_10 ___TRAIT_GENERIC_EMIT
+#define ___TRAIT_SD_EMIT_01 ___TRAIT_IMPLS_EMIT
+#define ___TRAIT_GENERIC_IS____TRAIT_GENERIC ___TRAIT_PROBE()
+#define ___TRAIT_GENERIC_IS(tuple)                                                 \
+  ___TRAIT_CHECK(glue(___TRAIT_GENERIC_IS_, ___TRAIT_SD_TUPLE_FIRST(tuple)))
+#define ___TRAIT_IMPLS_MARK_IS____TRAIT_IMPLS_MARK ___TRAIT_PROBE()
+#define ___TRAIT_IMPLS_MARK_IS(tuple)                                              \
+  ___TRAIT_CHECK(glue(___TRAIT_IMPLS_MARK_IS_, ___TRAIT_SD_TUPLE_FIRST(tuple)))
 #define ___TRAIT_SD_EMIT_I(NameSignature, ConstFlag, Ret, Name, ...)                 \
   typedef For glue8(___trait_sd_, ___TRAIT_SD_C6, ___TRAIT_SD_C5, ___TRAIT_SD_C4, ___TRAIT_SD_C3, ___TRAIT_SD_C2, ___TRAIT_SD_C1, _ty);   \
   typedef glue5(___sel_, NameSignature, _, Name, _t) glue8(                           \
       ___trait_sd_, ___TRAIT_SD_C6, ___TRAIT_SD_C5, ___TRAIT_SD_C4, ___TRAIT_SD_C3, ___TRAIT_SD_C2, ___TRAIT_SD_C1, _sty);               \
   typedef void (*glue8(___trait_sd_pair_, ___TRAIT_SD_C6, ___TRAIT_SD_C5, ___TRAIT_SD_C4, ___TRAIT_SD_C3, ___TRAIT_SD_C2, ___TRAIT_SD_C1, _p))(glue5(___sel_, NameSignature, _, Name, _t), For); \
+  ___TRAIT_SYMMAP(___TRAIT_SDREG_FN, For, NameSignature, Name, static)           \
   glue5(___TRAIT_SDREG_, 0, _, ConstFlag,                                            \
         ___TRAIT_NARG(__VA_ARGS__))(NameSignature, Ret, Name, ##__VA_ARGS__)
 
+// Impl marker (___TRAIT_IMPLS_MARK): the pair (Impl___sel_t, For) maps to the
+// enum constant 1, so implements(For, Impl) is an integer constant expression.
+#define ___TRAIT_IMPLS_EMIT(Marker)                                                 \
+  typedef For glue8(___trait_sd_, ___TRAIT_SD_C6, ___TRAIT_SD_C5, ___TRAIT_SD_C4, ___TRAIT_SD_C3, ___TRAIT_SD_C2, ___TRAIT_SD_C1, _ty);   \
+  typedef glue(Impl, ___sel_t) glue8(                                               \
+      ___trait_sd_, ___TRAIT_SD_C6, ___TRAIT_SD_C5, ___TRAIT_SD_C4, ___TRAIT_SD_C3, ___TRAIT_SD_C2, ___TRAIT_SD_C1, _sty);               \
+  typedef void (*glue8(___trait_sd_pair_, ___TRAIT_SD_C6, ___TRAIT_SD_C5, ___TRAIT_SD_C4, ___TRAIT_SD_C3, ___TRAIT_SD_C2, ___TRAIT_SD_C1, _p))(glue(Impl, ___sel_t), For); \
+  enum { ___TRAIT_SDREG_FN = 1 };
+
+// Generic tuple (___TRAIT_GENERIC, G): stamp G_For from GGeneric(For), then
+// register it under the selector type struct ___trait_generic_G *, so that
+// call_generic(G, obj, ...) picks it by the type of *obj.  The slot's "wrapper"
+// is a const pointer to G_For, which the compiler folds into a direct call.
+#define ___TRAIT_GENERIC_EMIT(Marker, G)                                            \
+  ___TRAIT_PASTE(G, Generic)(For)                                                   \
+  typedef For glue8(___trait_sd_, ___TRAIT_SD_C6, ___TRAIT_SD_C5, ___TRAIT_SD_C4, ___TRAIT_SD_C3, ___TRAIT_SD_C2, ___TRAIT_SD_C1, _ty);   \
+  typedef struct glue(___trait_generic_, G) *glue8(                                 \
+      ___trait_sd_, ___TRAIT_SD_C6, ___TRAIT_SD_C5, ___TRAIT_SD_C4, ___TRAIT_SD_C3, ___TRAIT_SD_C2, ___TRAIT_SD_C1, _sty);               \
+  typedef void (*glue8(___trait_sd_pair_, ___TRAIT_SD_C6, ___TRAIT_SD_C5, ___TRAIT_SD_C4, ___TRAIT_SD_C3, ___TRAIT_SD_C2, ___TRAIT_SD_C1, _p))(struct glue(___trait_generic_, G) *, For); \
+  ___TRAIT_UNUSED static ___TRAIT_TYPEOF(glue3(G, _, For)) *const ___TRAIT_SDREG_FN = \
+      glue3(G, _, For);
+
+// -----------------------------------------------------------------------------
+// TRAIT_PROFILE: per-slot call counters
+//
+// Compile with -DTRAIT_PROFILE to make every SDREG/DYNSDREG wrapper bump a
+// relaxed atomic counter the first statement it runs.  Each wrapper owns one
+// function-scope slot { type, trait, method, dynamic, count }; a pointer to it
+// is placed in the `trait_profile` section, so the linker collects the slots
+// of every TU and trait_profile_dump() walks them via __start_/__stop_:
+//   static:
+//          12  Dog.Animal.get_snacks
+//   dynamic:
+//           3  DynPet.Pet.Animal.get_snacks
+// Dynamic slots are per trait object type (the concrete type is only known
+// through the vtable); replayed base methods show their vtable path.
+// Wrappers that are never called emit no slot.  Requires GCC/Clang and an
+// ELF linker (section start/stop symbols); the two symbols are weak so a
+// program with no slots still links.
+// -----------------------------------------------------------------------------
+#ifdef TRAIT_PROFILE
+#include <stdio.h>
+
+struct trait_profile_slot {
+  const char *type, *trait, *method;
+  int dynamic;
+  unsigned long long count;
+};
+
+#define ___TRAIT_PROF_HIT(Dyn, Type, Trait, Name)                                  \
+  do {                                                                             \
+    static struct trait_profile_slot ___trait_prof_slot = {                        \
+        ___TRAIT_STR(Type), ___TRAIT_STR(Trait),                         \
+        ___TRAIT_STR(Name), Dyn, 0};                                          \
+    static struct trait_profile_slot *___trait_prof_ref                            \
+        __attribute__((__section__("trait_profile"), __used__)) =                  \
+            &___trait_prof_slot;                                                   \
+    __atomic_fetch_add(&___trait_prof_slot.count, 1, __ATOMIC_RELAXED);            \
+  } while (0)
+
+extern struct trait_profile_slot *__start_trait_profile[] __attribute__((__weak__));
+extern struct trait_profile_slot *__stop_trait_profile[] __attribute__((__weak__));
+
+// Prints every slot with a nonzero count, static slots first.
+___TRAIT_UNUSED static void trait_profile_dump(FILE *out) {
+  for (int dyn = 0; dyn < 2; dyn++) {
+    fputs(dyn ? "dynamic:\n" : "static:\n", out);
+    for (struct trait_profile_slot **p = __start_trait_profile;
+         p < __stop_trait_profile; p++)
+      if ((*p)->dynamic == dyn && (*p)->count)
+        fprintf(out, "  %12llu  %s.%s.%s\n", (*p)->count, (*p)->type,
+                (*p)->trait, (*p)->method);
+  }
+}
+
+___TRAIT_UNUSED static void trait_profile_reset(void) {
+  for (struct trait_profile_slot **p = __start_trait_profile;
+       p < __stop_trait_profile; p++)
+    __atomic_store_n(&(*p)->count, 0, __ATOMIC_RELAXED);
+}
+#else
+#define ___TRAIT_PROF_HIT(Dyn, Type, Trait, Name) ((void)0)
+#endif
+
+// -----------------------------------------------------------------------------
+// TRAIT_TRACE: sampled dynamic-call tracer
+//
+// Compile with -DTRAIT_TRACE to make every DYNSDREG wrapper (the one place
+// each vtable call passes through) sample itself.  Sampling is off until
+// trait_trace_set_rate(N) is called; then every Nth dynamic call on each
+// thread appends { timestamp, vtable, call site } to that thread's ring of
+// TRAIT_TRACE_RING events (oldest overwritten).  When off, a wrapper costs
+// one relaxed load and a predicted branch, so the build can stay in canaries.
+//   trait_trace_set_rate(64);
+//   ...
+//   trait_trace_dump_json(f);   // chrome://tracing, Perfetto
+//   trait_trace_dump_bin(f);    // compact binary, format below
+//   trait_trace_dump_pgo(f);    // (site, vtable) counts for pgo.sh
+// Each ring has a single writer and publishes its head with a release store,
+// so recording takes no lock; dump while the traced threads are quiet to get
+// a consistent snapshot.  Rings outlive their threads and are never freed.
+// Needs what TRAIT_PROFILE needs plus __thread and POSIX clock_gettime; the
+// globals are weak so every TU shares one set.
+// -----------------------------------------------------------------------------
+#ifdef TRAIT_TRACE
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#ifndef TRAIT_TRACE_RING
+#define TRAIT_TRACE_RING 4096 // events per thread, power of two
+#endif
+
+struct trait_trace_site {
+  const char *type, *trait, *method;
+  unsigned id; // index in the dump's site table
+};
+
+struct trait_trace_event {
+  unsigned long long ts; // CLOCK_MONOTONIC ns
+  const void *vtable;
+  struct trait_trace_site *site;
+};
+
+struct trait_trace_ring {
+  struct trait_trace_ring *next;
+  unsigned tid; // 1, 2, ... in order of each thread's first sample
+  unsigned long long head; // events ever written
+  struct trait_trace_event ev[TRAIT_TRACE_RING];
+};
+
+__attribute__((__weak__)) unsigned long long trait_trace_every;
+__attribute__((__weak__)) struct trait_trace_ring *trait_trace_rings;
+__attribute__((__weak__)) unsigned trait_trace_threads;
+__attribute__((__weak__)) __thread struct trait_trace_ring *trait_trace_self;
+__attribute__((__weak__)) __thread unsigned long long trait_trace_tick;
+
+extern struct trait_trace_site *__start_trait_trace[] __attribute__((__weak__));
+extern struct trait_trace_site *__stop_trait_trace[] __attribute__((__weak__));
+
+___TRAIT_UNUSED static void ___trait_trace_record(struct trait_trace_site *site,
+                                                  const void *vtable) {
+  if (++trait_trace_tick < __atomic_load_n(&trait_trace_every, __ATOMIC_RELAXED))
+    return;
+  trait_trace_tick = 0;
+  struct trait_trace_ring *r = trait_trace_self;
+  if (!r) {
+    if (!(r = (struct trait_trace_ring *)calloc(1, sizeof *r)))
+      return;
+    r->tid = __atomic_add_fetch(&trait_trace_threads, 1, __ATOMIC_RELAXED);
+    r->next = __atomic_load_n(&trait_trace_rings, __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&trait_trace_rings, &r->next, r, 1,
+                                        __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+      ;
+    trait_trace_self = r;
+  }
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  struct trait_trace_event *e = &r->ev[r->head & (TRAIT_TRACE_RING - 1)];
+  e->ts = (unsigned long long)t.tv_sec * 1000000000ull + (unsigned long long)t.tv_nsec;
+  e->vtable = vtable;
+  e->site = site;
+  __atomic_store_n(&r->head, r->head + 1, __ATOMIC_RELEASE);
+}
+
+#define ___TRAIT_TRACE_HIT(Type, Trait, Name, VT)                                  \
+  do {                                                                             \
+    static struct trait_trace_site ___trait_trace_site = {                         \
+        ___TRAIT_STR(Type), ___TRAIT_STR(Trait), ___TRAIT_STR(Name), 0};           \
+    static struct trait_trace_site *___trait_trace_ref                             \
+        __attribute__((__section__("trait_trace"), __used__)) =                    \
+            &___trait_trace_site;                                                  \
+    if (__builtin_expect(                                                          \
+            __atomic_load_n(&trait_trace_every, __ATOMIC_RELAXED) != 0, 0))        \
+      ___trait_trace_record(&___trait_trace_site, (const void *)(VT));             \
+  } while (0)
+
+// Sample every Nth dynamic call per thread; 0 stops sampling.
+___TRAIT_UNUSED static void trait_trace_set_rate(unsigned long long every) {
+  __atomic_store_n(&trait_trace_every, every, __ATOMIC_RELAXED);
+}
+
+// Drops every recorded event (rings stay allocated).
+___TRAIT_UNUSED static void trait_trace_reset(void) {
+  for (struct trait_trace_ring *r = __atomic_load_n(&trait_trace_rings, __ATOMIC_ACQUIRE);
+       r; r = r->next)
+    __atomic_store_n(&r->head, 0, __ATOMIC_RELEASE);
+}
+
+// Calls fn on each retained event of each ring, oldest first.
+___TRAIT_UNUSED static void ___trait_trace_each(
+    void (*fn)(FILE *, const struct trait_trace_ring *, const struct trait_trace_event *, int),
+    FILE *out) {
+  int first = 1;
+  for (struct trait_trace_ring *r = __atomic_load_n(&trait_trace_rings, __ATOMIC_ACQUIRE);
+       r; r = r->next) {
+    unsigned long long head = __atomic_load_n(&r->head, __ATOMIC_ACQUIRE);
+    unsigned long long i = head > TRAIT_TRACE_RING ? head - TRAIT_TRACE_RING : 0;
+    for (; i < head; i++, first = 0)
+      fn(out, r, &r->ev[i & (TRAIT_TRACE_RING - 1)], first);
+  }
+}
+
+___TRAIT_UNUSED static void ___trait_trace_json_event(FILE *out,
+                                                      const struct trait_trace_ring *r,
+                                                      const struct trait_trace_event *e,
+                                                      int first) {
+  fprintf(out,
+          "%s\n{\"name\":\"%s.%s\",\"cat\":\"%s\",\"ph\":\"i\",\"s\":\"t\","
+          "\"ts\":%llu.%03llu,\"pid\":1,\"tid\":%u,\"args\":{\"vtable\":\"%p\"}}",
+          first ? "" : ",", e->site->trait, e->site->method, e->site->type,
+          e->ts / 1000, e->ts % 1000, r->tid, e->vtable);
+}
+
+// Chrome trace event format: one instant event per sample, named
+// Trait.method, category DynTrait, with the vtable address in args.
+___TRAIT_UNUSED static void trait_trace_dump_json(FILE *out) {
+  fputs("{\"traceEvents\":[", out);
+  ___trait_trace_each(___trait_trace_json_event, out);
+  fputs("\n],\"displayTimeUnit\":\"ns\"}\n", out);
+}
+
+___TRAIT_UNUSED static void ___trait_trace_bin_event(FILE *out,
+                                                     const struct trait_trace_ring *r,
+                                                     const struct trait_trace_event *e,
+                                                     int first) {
+  unsigned long long rec[2] = {e->ts, (unsigned long long)(__UINTPTR_TYPE__)e->vtable};
+  unsigned id[2] = {r->tid, e->site->id};
+  (void)first;
+  fwrite(rec, sizeof rec, 1, out);
+  fwrite(id, sizeof id, 1, out);
+}
+
+// Compact binary, native endianness:
+//   "TRTRACE1", u32 site count, then per site "Type\0Trait\0method\0",
+//   then per event { u64 ts_ns; u64 vtable; u32 tid; u32 site index; }.
+___TRAIT_UNUSED static void trait_trace_dump_bin(FILE *out) {
+  unsigned n = 0;
+  for (struct trait_trace_site **p = __start_trait_trace; p < __stop_trait_trace; p++)
+    (*p)->id = n++;
+  fwrite("TRTRACE1", 8, 1, out);
+  fwrite(&n, sizeof n, 1, out);
+  for (struct trait_trace_site **p = __start_trait_trace; p < __stop_trait_trace; p++)
+    fprintf(out, "%s%c%s%c%s%c", (*p)->type, 0, (*p)->trait, 0, (*p)->method, 0);
+  ___trait_trace_each(___trait_trace_bin_event, out);
+}
+
+struct ___trait_trace_pair {
+  const struct trait_trace_site *site;
+  const void *vtable;
+};
+
+___TRAIT_UNUSED static int ___trait_trace_pair_cmp(const void *a, const void *b) {
+  const struct ___trait_trace_pair *x = (const struct ___trait_trace_pair *)a;
+  const struct ___trait_trace_pair *y = (const struct ___trait_trace_pair *)b;
+  if (x->site != y->site) return x->site < y->site ? -1 : 1;
+  if (x->vtable != y->vtable) return x->vtable < y->vtable ? -1 : 1;
+  return 0;
+}
+
+// Profile for pgo.sh: retained events counted per (call site, vtable).
+//   anchor 0x55d0c2a4e010
+//   1834 DynAnimal Animal get_snacks 0x55d0c2a4bd48
+// The anchor is &trait_trace_every, so pgo.sh can map the vtable addresses of
+// a PIE back to For_Trait_vtable symbols with nm.
+___TRAIT_UNUSED static void trait_trace_dump_pgo(FILE *out) {
+  size_t n = 0, i = 0, j;
+  struct trait_trace_ring *r;
+  for (r = __atomic_load_n(&trait_trace_rings, __ATOMIC_ACQUIRE); r; r = r->next) {
+    unsigned long long h = __atomic_load_n(&r->head, __ATOMIC_ACQUIRE);
+    n += h > TRAIT_TRACE_RING ? TRAIT_TRACE_RING : (size_t)h;
+  }
+  fprintf(out, "anchor %p\n", (void *)&trait_trace_every);
+  struct ___trait_trace_pair *v =
+      (struct ___trait_trace_pair *)malloc((n ? n : 1) * sizeof *v);
+  if (!v) return;
+  for (r = __atomic_load_n(&trait_trace_rings, __ATOMIC_ACQUIRE); r && i < n; r = r->next) {
+    unsigned long long h = __atomic_load_n(&r->head, __ATOMIC_ACQUIRE);
+    unsigned long long k = h > TRAIT_TRACE_RING ? h - TRAIT_TRACE_RING : 0;
+    for (; k < h && i < n; k++, i++) {
+      v[i].site = r->ev[k & (TRAIT_TRACE_RING - 1)].site;
+      v[i].vtable = r->ev[k & (TRAIT_TRACE_RING - 1)].vtable;
+    }
+  }
+  qsort(v, i, sizeof *v, ___trait_trace_pair_cmp);
+  for (n = i, i = 0; i < n; i = j) {
+    for (j = i + 1; j < n && !___trait_trace_pair_cmp(&v[i], &v[j]); j++)
+      ;
+    fprintf(out, "%lu %s %s %s %p\n", (unsigned long)(j - i), v[i].site->type,
+            v[i].site->trait, v[i].site->method, v[i].vtable);
+  }
+  free(v);
+}
+#else
+#define ___TRAIT_TRACE_HIT(Type, Trait, Name, VT) ((void)0)
+#endif
+
+// -----------------------------------------------------------------------------
+// TRAIT_SYMMAP: readable names for generated wrappers
+//
+// With -DTRAIT_SYMMAP every SD/DynSD/TT wrapper gets a string in the
+// `trait_symmap` section naming what it dispatches to:
+//   "___trait_sd_fn_000004 Dog.Animal.get_snacks static"
+//   "___trait_sd_fn_000011 DynPet.Pet.Animal.get_snacks dyn"
+//   "___trait_sd_fn_000013 DynPet.upcast.Animal upcast"
+//   "___trait_tt_fn_000002 Dog.Animal.dyn tt"
+// symmap.sh reads the table from an object, executable or .s file and
+// rewrites perf script / assembly output with these names.  Slot numbers
+// are per TU, so map each TU's output with its own table.  The entries are
+// __used__ and kept even when the wrapper is not, so this is a diagnostics
+// build only.
+// -----------------------------------------------------------------------------
+#ifdef TRAIT_SYMMAP
+#define ___TRAIT_SYMMAP(Fn, Type, Trait, Name, Kind)                               \
+  __attribute__((__section__("trait_symmap"), __used__)) static const char       \
+      glue(Fn, _symmap)[] = ___TRAIT_STR(Fn) " " ___TRAIT_STR(Type) "."           \
+      ___TRAIT_STR(Trait) "." ___TRAIT_STR(Name) " " #Kind;
+#else
+#define ___TRAIT_SYMMAP(Fn, Type, Trait, Name, Kind)
+#endif
+
 // -----------------------------------------------------------------------------
 // SDREG: SD wrapper function emitters
 //
@@ -1785,94 +3187,114 @@ extern struct ERROR_type_not_impl_for_this_trait ERROR_type_not_impl_for_this_tr
 // ── non-void return ─────────────────────────────────────────────────────────
 #define ___TRAIT_SDREG_0_00(NameSignature, Ret, Name)                                \
   ___TRAIT_UNUSED static inline Ret ___TRAIT_SDREG_FN(For * self) {                \
+    ___TRAIT_PROF_HIT(0, For, NameSignature, Name);                              \
     ___TRAIT_RETURN(___TRAIT_SDREG_IMPL(NameSignature, Name)(self));                 \
   }
 #define ___TRAIT_SDREG_0_10(NameSignature, Ret, Name)                                \
   ___TRAIT_UNUSED static inline Ret ___TRAIT_SDREG_FN(const For *self) {           \
+    ___TRAIT_PROF_HIT(0, For, NameSignature, Name);                              \
     ___TRAIT_RETURN(___TRAIT_SDREG_IMPL(NameSignature, Name)(self));                 \
   }
 #define ___TRAIT_SDREG_0_01(NameSignature, Ret, Name, T1)                            \
   ___TRAIT_UNUSED static inline Ret ___TRAIT_SDREG_FN(For * self, T1 a1) {         \
+    ___TRAIT_PROF_HIT(0, For, NameSignature, Name);                              \
     ___TRAIT_RETURN(___TRAIT_SDREG_IMPL(NameSignature, Name)(self, a1));             \
   }
 #define ___TRAIT_SDREG_0_11(NameSignature, Ret, Name, T1)                            \
   ___TRAIT_UNUSED static inline Ret ___TRAIT_SDREG_FN(const For *self, T1 a1) {    \
+    ___TRAIT_PROF_HIT(0, For, NameSignature, Name);                              \
     ___TRAIT_RETURN(___TRAIT_SDREG_IMPL(NameSignature, Name)(self, a1));             \
   }
 #define ___TRAIT_SDREG_0_02(NameSignature, Ret, Name, T1, T2)                        \
   ___TRAIT_UNUSED static inline Ret ___TRAIT_SDREG_FN(For * self, T1 a1, T2 a2) {  \
+    ___TRAIT_PROF_HIT(0, For, NameSignature, Name);                              \
     ___TRAIT_RETURN(___TRAIT_SDREG_IMPL(NameSignature, Name)(self, a1, a2));         \
   }
 #define ___TRAIT_SDREG_0_12(NameSignature, Ret, Name, T1, T2)                        \
   ___TRAIT_UNUSED static inline Ret ___TRAIT_SDREG_FN(const For *self, T1 a1,      \
                                                     T2 a2) {                    \
+    ___TRAIT_PROF_HIT(0, For, NameSignature, Name);                              \
     ___TRAIT_RETURN(___TRAIT_SDREG_IMPL(NameSignature, Name)(self, a1, a2));         \
   }
 #define ___TRAIT_SDREG_0_03(NameSignature, Ret, Name, T1, T2, T3)                    \
   ___TRAIT_UNUSED static inline Ret ___TRAIT_SDREG_FN(For * self, T1 a1, T2 a2,    \
                                                     T3 a3) {                    \
+    ___TRAIT_PROF_HIT(0, For, NameSignature, Name);                              \
     ___TRAIT_RETURN(___TRAIT_SDREG_IMPL(NameSignature, Name)(self, a1, a2, a3));     \
   }
 #define ___TRAIT_SDREG_0_13(NameSignature, Ret, Name, T1, T2, T3)                    \
   ___TRAIT_UNUSED static inline Ret ___TRAIT_SDREG_FN(const For *self, T1 a1,      \
                                                     T2 a2, T3 a3) {            \
+    ___TRAIT_PROF_HIT(0, For, NameSignature, Name);                              \
     ___TRAIT_RETURN(___TRAIT_SDREG_IMPL(NameSignature, Name)(self, a1, a2, a3));     \
   }
 #define ___TRAIT_SDREG_0_04(NameSignature, Ret, Name, T1, T2, T3, T4)                \
   ___TRAIT_UNUSED static inline Ret ___TRAIT_SDREG_FN(For * self, T1 a1, T2 a2,    \
                                                     T3 a3, T4 a4) {            \
+    ___TRAIT_PROF_HIT(0, For, NameSignature, Name);                              \
     ___TRAIT_RETURN(___TRAIT_SDREG_IMPL(NameSignature, Name)(self, a1, a2, a3, a4)); \
   }
 #define ___TRAIT_SDREG_0_14(NameSignature, Ret, Name, T1, T2, T3, T4)                \
   ___TRAIT_UNUSED static inline Ret ___TRAIT_SDREG_FN(const For *self, T1 a1,      \
                                                     T2 a2, T3 a3, T4 a4) {     \
+    ___TRAIT_PROF_HIT(0, For, NameSignature, Name);                              \
     ___TRAIT_RETURN(___TRAIT_SDREG_IMPL(NameSignature, Name)(self, a1, a2, a3, a4)); \
   }
 
 // ── void return ─────────────────────────────────────────────────────────────
 #define ___TRAIT_SDREG_1_00(NameSignature, Ret, Name)                                \
   ___TRAIT_UNUSED static inline void ___TRAIT_SDREG_FN(For * self) {               \
+    ___TRAIT_PROF_HIT(0, For, NameSignature, Name);                              \
     ___TRAIT_SDREG_IMPL(NameSignature, Name)(self);                                  \
   }
 #define ___TRAIT_SDREG_1_10(NameSignature, Ret, Name)                                \
   ___TRAIT_UNUSED static inline void ___TRAIT_SDREG_FN(const For *self) {          \
+    ___TRAIT_PROF_HIT(0, For, NameSignature, Name);                              \
     ___TRAIT_SDREG_IMPL(NameSignature, Name)(self);                                  \
   }
 #define ___TRAIT_SDREG_1_01(NameSignature, Ret, Name, T1)                            \
   ___TRAIT_UNUSED static inline void ___TRAIT_SDREG_FN(For * self, T1 a1) {        \
+    ___TRAIT_PROF_HIT(0, For, NameSignature, Name);                              \
     ___TRAIT_SDREG_IMPL(NameSignature, Name)(self, a1);                              \
   }
 #define ___TRAIT_SDREG_1_11(NameSignature, Ret, Name, T1)                            \
   ___TRAIT_UNUSED static inline void ___TRAIT_SDREG_FN(const For *self, T1 a1) {   \
+    ___TRAIT_PROF_HIT(0, For, NameSignature, Name);                              \
     ___TRAIT_SDREG_IMPL(NameSignature, Name)(self, a1);                              \
   }
 #define ___TRAIT_SDREG_1_02(NameSignature, Ret, Name, T1, T2)                        \
   ___TRAIT_UNUSED static inline void ___TRAIT_SDREG_FN(For * self, T1 a1, T2 a2) { \
+    ___TRAIT_PROF_HIT(0, For, NameSignature, Name);                              \
     ___TRAIT_SDREG_IMPL(NameSignature, Name)(self, a1, a2);                          \
   }
 #define ___TRAIT_SDREG_1_12(NameSignature, Ret, Name, T1, T2)                        \
   ___TRAIT_UNUSED static inline void ___TRAIT_SDREG_FN(const For *self, T1 a1,     \
                                                      T2 a2) {                   \
+    ___TRAIT_PROF_HIT(0, For, NameSignature, Name);                              \
     ___TRAIT_SDREG_IMPL(NameSignature, Name)(self, a1, a2);                          \
   }
 #define ___TRAIT_SDREG_1_03(NameSignature, Ret, Name, T1, T2, T3)                    \
   ___TRAIT_UNUSED static inline void ___TRAIT_SDREG_FN(For * self, T1 a1, T2 a2,   \
                                                      T3 a3) {                   \
+    ___TRAIT_PROF_HIT(0, For, NameSignature, Name);                              \
     ___TRAIT_SDREG_IMPL(NameSignature, Name)(self, a1, a2, a3);                      \
   }
 #define ___TRAIT_SDREG_1_13(NameSignature, Ret, Name, T1, T2, T3)                    \
   ___TRAIT_UNUSED static inline void ___TRAIT_SDREG_FN(const For *self, T1 a1,     \
                                                      T2 a2, T3 a3) {           \
+    ___TRAIT_PROF_HIT(0, For, NameSignature, Name);                              \
     ___TRAIT_SDREG_IMPL(NameSignature, Name)(self, a1, a2, a3);                      \
   }
 #define ___TRAIT_SDREG_1_04(NameSignature, Ret, Name, T1, T2, T3, T4)                \
   ___TRAIT_UNUSED static inline void ___TRAIT_SDREG_FN(For * self, T1 a1, T2 a2,   \
                                                      T3 a3, T4 a4) {           \
+    ___TRAIT_PROF_HIT(0, For, NameSignature, Name);                              \
     ___TRAIT_SDREG_IMPL(NameSignature, Name)(self, a1, a2, a3, a4);                  \
   }
 #define ___TRAIT_SDREG_1_14(NameSignature, Ret, Name, T1, T2, T3, T4)                \
   ___TRAIT_UNUSED static inline void ___TRAIT_SDREG_FN(const For *self, T1 a1,     \
                                                      T2 a2, T3 a3, T4 a4) {    \
+    ___TRAIT_PROF_HIT(0, For, NameSignature, Name);                              \
     ___TRAIT_SDREG_IMPL(NameSignature, Name)(self, a1, a2, a3, a4);                  \
   }
 
@@ -1885,45 +3307,176 @@ extern struct ERROR_type_not_impl_for_this_trait ERROR_type_not_impl_for_this_tr
 // self-include loop after the normal SD loop in impl registration.
 // =============================================================================
 
+// The trait object type the DynSD wrappers take, and the member of it holding
+// the vtable pointer.  A plain trait object is DynImpl with its `vt` field; a
+// multi-trait object (Dyn2(A, B), see below) redefines both for the duration
+// of its DynSD loops so that each member trait routes through its own field.
+#define ___TRAIT_DYNSD_SELF glue(Dyn, Impl)
+#define ___TRAIT_DYNSD_VT vt
+
 // -----------------------------------------------------------------------------
 // DYNSD registration emission
 //
 // Like ___TRAIT_SD_EMIT but uses DynImpl as the concrete type and generates
 // vtable-dispatching wrapper functions instead of direct-call wrappers.
 // -----------------------------------------------------------------------------
-#define ___TRAIT_DYNSD_EMIT(tuple) ___TRAIT_DYNSD_EMIT_D tuple
-// Dispatch: replayed base tuples carry ___TRAIT_VT at position 4; own tuples
-// carry the method name.  glue(___TRAIT_DYNVT_, ___TRAIT_VT) yields
-// ___TRAIT_DYNVT____TRAIT_VT (note: four underscores at the junction — the
-// prefix ends in one, the marker begins with three), the only defined
-// ___TRAIT_DYNVT_* token, so ___TRAIT_CHECK selects 1 vs 0.
+#define ___TRAIT_DYNSD_EMIT(tuple)                                                 \
+  glue(___TRAIT_DYNSD_EMIT_UP_, ___TRAIT_UP_IS(tuple)) tuple
+#define ___TRAIT_DYNSD_EMIT_UP_0 ___TRAIT_DYNSD_EMIT_D
+#define ___TRAIT_DYNSD_EMIT_UP_1 ___TRAIT_UPSD_EMIT
+#define ___TRAIT_UP_IS____TRAIT_UP ___TRAIT_PROBE()
+#define ___TRAIT_UP_IS(tuple)                                                      \
+  ___TRAIT_CHECK(glue(___TRAIT_UP_IS_, ___TRAIT_SD_TUPLE_FIRST(tuple)))
+// Dispatch: replayed base tuples carry ___TRAIT_VT (or ___TRAIT_VTP for a
+// shared base) at position 4; own tuples carry the method name.
+// glue(___TRAIT_DYNVT_, ___TRAIT_VT) yields ___TRAIT_DYNVT____TRAIT_VT (note:
+// four underscores at the junction — the prefix ends in one, the marker
+// begins with three); the two markers are the only defined ___TRAIT_DYNVT_*
+// tokens, so ___TRAIT_CHECK selects 1 vs 0.
 #define ___TRAIT_DYNSD_EMIT_D(NameSignature, ConstFlag, Ret, T4, ...)                \
   glue(___TRAIT_DYNSD_EMIT_,                                                         \
        ___TRAIT_CHECK(glue(___TRAIT_DYNVT_, T4)))(                                   \
       NameSignature, ConstFlag, Ret, T4, ##__VA_ARGS__)
 #define ___TRAIT_DYNVT____TRAIT_VT ___TRAIT_PROBE()
+#define ___TRAIT_DYNVT____TRAIT_VTP ___TRAIT_PROBE()
+
+// Member access for a replayed base method: Base.Name for an embedded base
+// (extends), Base->Name for a shared one (extends_shared).
+#define ___TRAIT_VT_FIELD(VT, Base, Name) glue(___TRAIT_VT_FIELD_, VT)(Base, Name)
+#define ___TRAIT_VT_FIELD____TRAIT_VT(Base, Name) Base.Name
+#define ___TRAIT_VT_FIELD____TRAIT_VTP(Base, Name) Base->Name
 
 // Own method tuple: (NameSignature, ConstFlag, Ret, Name, ExtraArgs...)
 #define ___TRAIT_DYNSD_EMIT_0(NameSignature, ConstFlag, Ret, Name, ...)              \
-  typedef glue(Dyn, Impl) glue8(___trait_sd_, ___TRAIT_SD_C6, ___TRAIT_SD_C5,       \
+  typedef ___TRAIT_DYNSD_SELF glue8(___trait_sd_, ___TRAIT_SD_C6, ___TRAIT_SD_C5,       \
                                   ___TRAIT_SD_C4, ___TRAIT_SD_C3, ___TRAIT_SD_C2, ___TRAIT_SD_C1, _ty);  \
   typedef glue5(___sel_, NameSignature, _, Name, _t) glue8(                           \
       ___trait_sd_, ___TRAIT_SD_C6, ___TRAIT_SD_C5, ___TRAIT_SD_C4, ___TRAIT_SD_C3, ___TRAIT_SD_C2, ___TRAIT_SD_C1, _sty);               \
-  typedef void (*glue8(___trait_sd_pair_, ___TRAIT_SD_C6, ___TRAIT_SD_C5, ___TRAIT_SD_C4, ___TRAIT_SD_C3, ___TRAIT_SD_C2, ___TRAIT_SD_C1, _p))(glue5(___sel_, NameSignature, _, Name, _t), glue(Dyn, Impl)); \
+  typedef void (*glue8(___trait_sd_pair_, ___TRAIT_SD_C6, ___TRAIT_SD_C5, ___TRAIT_SD_C4, ___TRAIT_SD_C3, ___TRAIT_SD_C2, ___TRAIT_SD_C1, _p))(glue5(___sel_, NameSignature, _, Name, _t), ___TRAIT_DYNSD_SELF); \
+  ___TRAIT_SYMMAP(___TRAIT_SDREG_FN, ___TRAIT_DYNSD_SELF, Impl, Name, dyn)       \
   glue5(___TRAIT_DYNSDREG_, 0, _, ConstFlag,                                         \
-        ___TRAIT_NARG(__VA_ARGS__))(Ret, Name, ##__VA_ARGS__)
+        ___TRAIT_NARG(__VA_ARGS__))(Ret, glue4(Hint_, Impl, _, Name), Name, ##__VA_ARGS__)
 
 // Replayed base method tuple:
-// (NameSignature, ConstFlag, Ret, ___TRAIT_VT, Name, ExtraArgs...)
-// The wrapper routes through the embedded base vtable field: NameSignature.Name.
+// (NameSignature, ConstFlag, Ret, ___TRAIT_VT | ___TRAIT_VTP, Name, ExtraArgs...)
+// The wrapper routes through the base vtable field: NameSignature.Name, or
+// NameSignature->Name for a shared base.
 #define ___TRAIT_DYNSD_EMIT_1(NameSignature, ConstFlag, Ret, VT, Name, ...)          \
-  typedef glue(Dyn, Impl) glue8(___trait_sd_, ___TRAIT_SD_C6, ___TRAIT_SD_C5,       \
+  typedef ___TRAIT_DYNSD_SELF glue8(___trait_sd_, ___TRAIT_SD_C6, ___TRAIT_SD_C5,       \
                                   ___TRAIT_SD_C4, ___TRAIT_SD_C3, ___TRAIT_SD_C2, ___TRAIT_SD_C1, _ty);  \
   typedef glue5(___sel_, NameSignature, _, Name, _t) glue8(                           \
       ___trait_sd_, ___TRAIT_SD_C6, ___TRAIT_SD_C5, ___TRAIT_SD_C4, ___TRAIT_SD_C3, ___TRAIT_SD_C2, ___TRAIT_SD_C1, _sty);               \
-  typedef void (*glue8(___trait_sd_pair_, ___TRAIT_SD_C6, ___TRAIT_SD_C5, ___TRAIT_SD_C4, ___TRAIT_SD_C3, ___TRAIT_SD_C2, ___TRAIT_SD_C1, _p))(glue5(___sel_, NameSignature, _, Name, _t), glue(Dyn, Impl)); \
+  typedef void (*glue8(___trait_sd_pair_, ___TRAIT_SD_C6, ___TRAIT_SD_C5, ___TRAIT_SD_C4, ___TRAIT_SD_C3, ___TRAIT_SD_C2, ___TRAIT_SD_C1, _p))(glue5(___sel_, NameSignature, _, Name, _t), ___TRAIT_DYNSD_SELF); \
+  ___TRAIT_SYMMAP(___TRAIT_SDREG_FN, ___TRAIT_DYNSD_SELF, Impl, NameSignature.Name, dyn)\
   glue5(___TRAIT_DYNSDREG_, 0, _, ConstFlag,                                         \
-        ___TRAIT_NARG(__VA_ARGS__))(Ret, NameSignature.Name, ##__VA_ARGS__)
+        ___TRAIT_NARG(__VA_ARGS__))(Ret, glue4(Hint_, NameSignature, _, Name), ___TRAIT_VT_FIELD(VT, NameSignature, Name), ##__VA_ARGS__)
+
+// Upcast tuple: (___TRAIT_UP, Base, Path)
+// Registers the pair void (*)(Base___up_t (*)[N], DynImpl) whose wrapper
+// returns (DynBase){self->self, &self->Path} — the base vtable is embedded
+// by value, so this is a constant offset from vt.  N is 1 for the first path
+// to Base; a diamond base reached again gets 1 + K (K = list position), which
+// keeps the _Generic pair types unique while upcast() only ever asks for [1].
+#define ___TRAIT_UPSD_EMIT(Up, Base, Path)                                           \
+  typedef ___TRAIT_DYNSD_SELF glue8(___trait_sd_, ___TRAIT_SD_C6, ___TRAIT_SD_C5,       \
+                                  ___TRAIT_SD_C4, ___TRAIT_SD_C3, ___TRAIT_SD_C2, ___TRAIT_SD_C1, _ty);  \
+  typedef glue(Base, ___up_t) glue8(                                                  \
+      ___trait_sd_, ___TRAIT_SD_C6, ___TRAIT_SD_C5, ___TRAIT_SD_C4, ___TRAIT_SD_C3, ___TRAIT_SD_C2, ___TRAIT_SD_C1, _sty);               \
+  typedef void (*glue8(___trait_sd_pair_, ___TRAIT_SD_C6, ___TRAIT_SD_C5, ___TRAIT_SD_C4, ___TRAIT_SD_C3, ___TRAIT_SD_C2, ___TRAIT_SD_C1, _p))( \
+      glue(Base, ___up_t) (*)[1 + ___TRAIT_DYNSD_PASS *                               \
+                                  (___TRAIT_UP_DUP(___TRAIT_DYNSD_PASS, Impl))],        \
+      ___TRAIT_DYNSD_SELF);                                                          \
+  ___TRAIT_SYMMAP(___TRAIT_SDREG_FN, ___TRAIT_DYNSD_SELF, upcast, Base, upcast)     \
+  ___TRAIT_UNUSED static inline ___TRAIT_DYN(Base) ___TRAIT_SDREG_FN(                \
+      const ___TRAIT_DYNSD_SELF *self) {                                             \
+    return (___TRAIT_DYN(Base)){self->self, &self->Path};                            \
+  }
+
+// ___TRAIT_UP_DUP(K, TraitImpl) → nonzero if the upcast target of entry K also
+// appears at an earlier position of the DynSD list.  Comparison is on the
+// ___up_t tag types (_Generic here, __builtin_types_compatible_p in CE mode),
+// so it is an integer constant expression usable as an array bound.
+struct ___trait_up_none;
+#define ___TRAIT_UP_TYPE(tuple) glue(___TRAIT_UP_TYPE_, ___TRAIT_UP_IS(tuple)) tuple
+#define ___TRAIT_UP_TYPE_0(...) struct ___trait_up_none
+#define ___TRAIT_UP_TYPE_1(Up, Base, Path) glue(Base, ___up_t)
+#define ___TRAIT_UP_SAME(t, a)                                                     \
+  _Generic((___TRAIT_UP_TYPE(t) *)0, ___TRAIT_UP_TYPE(a) *: 1, default: 0)
+#define ___TRAIT_UP_DUP(K, TraitImpl)                                              \
+  ___TRAIT_SD_APPLY(glue(___TRAIT_UP_DUP_, K), ___TRAIT_DYNSD_SELECT(K, TraitImpl), \
+                    ___TRAIT_DYNSD_LIST(TraitImpl))
+#define ___TRAIT_UP_DUP_0(t, ...) 0
+#define ___TRAIT_UP_DUP_1(t, d, a, ...) ___TRAIT_UP_SAME(t, a) | ___TRAIT_UP_DUP_0(t, d, __VA_ARGS__)
+#define ___TRAIT_UP_DUP_2(t, d, a, ...) ___TRAIT_UP_SAME(t, a) | ___TRAIT_UP_DUP_1(t, d, __VA_ARGS__)
+#define ___TRAIT_UP_DUP_3(t, d, a, ...) ___TRAIT_UP_SAME(t, a) | ___TRAIT_UP_DUP_2(t, d, __VA_ARGS__)
+#define ___TRAIT_UP_DUP_4(t, d, a, ...) ___TRAIT_UP_SAME(t, a) | ___TRAIT_UP_DUP_3(t, d, __VA_ARGS__)
+#define ___TRAIT_UP_DUP_5(t, d, a, ...) ___TRAIT_UP_SAME(t, a) | ___TRAIT_UP_DUP_4(t, d, __VA_ARGS__)
+#define ___TRAIT_UP_DUP_6(t, d, a, ...) ___TRAIT_UP_SAME(t, a) | ___TRAIT_UP_DUP_5(t, d, __VA_ARGS__)
+#define ___TRAIT_UP_DUP_7(t, d, a, ...) ___TRAIT_UP_SAME(t, a) | ___TRAIT_UP_DUP_6(t, d, __VA_ARGS__)
+#define ___TRAIT_UP_DUP_8(t, d, a, ...) ___TRAIT_UP_SAME(t, a) | ___TRAIT_UP_DUP_7(t, d, __VA_ARGS__)
+#define ___TRAIT_UP_DUP_9(t, d, a, ...) ___TRAIT_UP_SAME(t, a) | ___TRAIT_UP_DUP_8(t, d, __VA_ARGS__)
+#define ___TRAIT_UP_DUP_10(t, d, a, ...) ___TRAIT_UP_SAME(t, a) | ___TRAIT_UP_DUP_9(t, d, __VA_ARGS__)
+#define ___TRAIT_UP_DUP_11(t, d, a, ...) ___TRAIT_UP_SAME(t, a) | ___TRAIT_UP_DUP_10(t, d, __VA_ARGS__)
+#define ___TRAIT_UP_DUP_12(t, d, a, ...) ___TRAIT_UP_SAME(t, a) | ___TRAIT_UP_DUP_11(t, d, __VA_ARGS__)
+#define ___TRAIT_UP_DUP_13(t, d, a, ...) ___TRAIT_UP_SAME(t, a) | ___TRAIT_UP_DUP_12(t, d, __VA_ARGS__)
+#define ___TRAIT_UP_DUP_14(t, d, a, ...) ___TRAIT_UP_SAME(t, a) | ___TRAIT_UP_DUP_13(t, d, __VA_ARGS__)
+#define ___TRAIT_UP_DUP_15(t, d, a, ...) ___TRAIT_UP_SAME(t, a) | ___TRAIT_UP_DUP_14(t, d, __VA_ARGS__)
+#define ___TRAIT_UP_DUP_16(t, d, a, ...) ___TRAIT_UP_SAME(t, a) | ___TRAIT_UP_DUP_15(t, d, __VA_ARGS__)
+#define ___TRAIT_UP_DUP_17(t, d, a, ...) ___TRAIT_UP_SAME(t, a) | ___TRAIT_UP_DUP_16(t, d, __VA_ARGS__)
+#define ___TRAIT_UP_DUP_18(t, d, a, ...) ___TRAIT_UP_SAME(t, a) | ___TRAIT_UP_DUP_17(t, d, __VA_ARGS__)
+#define ___TRAIT_UP_DUP_19(t, d, a, ...) ___TRAIT_UP_SAME(t, a) | ___TRAIT_UP_DUP_18(t, d, __VA_ARGS__)
+#define ___TRAIT_UP_DUP_20(t, d, a, ...) ___TRAIT_UP_SAME(t, a) | ___TRAIT_UP_DUP_19(t, d, __VA_ARGS__)
+#define ___TRAIT_UP_DUP_21(t, d, a, ...) ___TRAIT_UP_SAME(t, a) | ___TRAIT_UP_DUP_20(t, d, __VA_ARGS__)
+#define ___TRAIT_UP_DUP_22(t, d, a, ...) ___TRAIT_UP_SAME(t, a) | ___TRAIT_UP_DUP_21(t, d, __VA_ARGS__)
+#define ___TRAIT_UP_DUP_23(t, d, a, ...) ___TRAIT_UP_SAME(t, a) | ___TRAIT_UP_DUP_22(t, d, __VA_ARGS__)
+#define ___TRAIT_UP_DUP_24(t, d, a, ...) ___TRAIT_UP_SAME(t, a) | ___TRAIT_UP_DUP_23(t, d, __VA_ARGS__)
+#define ___TRAIT_UP_DUP_25(t, d, a, ...) ___TRAIT_UP_SAME(t, a) | ___TRAIT_UP_DUP_24(t, d, __VA_ARGS__)
+#define ___TRAIT_UP_DUP_26(t, d, a, ...) ___TRAIT_UP_SAME(t, a) | ___TRAIT_UP_DUP_25(t, d, __VA_ARGS__)
+#define ___TRAIT_UP_DUP_27(t, d, a, ...) ___TRAIT_UP_SAME(t, a) | ___TRAIT_UP_DUP_26(t, d, __VA_ARGS__)
+#define ___TRAIT_UP_DUP_28(t, d, a, ...) ___TRAIT_UP_SAME(t, a) | ___TRAIT_UP_DUP_27(t, d, __VA_ARGS__)
+#define ___TRAIT_UP_DUP_29(t, d, a, ...) ___TRAIT_UP_SAME(t, a) | ___TRAIT_UP_DUP_28(t, d, __VA_ARGS__)
+#define ___TRAIT_UP_DUP_30(t, d, a, ...) ___TRAIT_UP_SAME(t, a) | ___TRAIT_UP_DUP_29(t, d, __VA_ARGS__)
+#define ___TRAIT_UP_DUP_31(t, d, a, ...) ___TRAIT_UP_SAME(t, a) | ___TRAIT_UP_DUP_30(t, d, __VA_ARGS__)
+
+// -----------------------------------------------------------------------------
+// Profile-guided hints: guarded direct calls in DynSD wrappers
+//
+// A hint names the implementation that most calls of Trait.method reach:
+//   #define Hint_Animal_get_snacks (Dog_Animal_get_snacks)
+// Every DynSD wrapper dispatching Animal.get_snacks (on DynAnimal, on
+// DynPet as a replayed base method, in multi-trait objects) then compares
+// the vtable slot with that function and calls it directly when it matches:
+//   if (__builtin_expect(self->vt->get_snacks == hot, 1)) return hot(self->self);
+//   return self->vt->get_snacks(self->self);
+// The wrappers are emitted with the trait, before the implementing type
+// exists, so the function is declared at block scope with the slot's type and
+// bound to its symbol with an asm label.  It must therefore have external
+// linkage: a def()/constdef() body, not a default that was not overridden.
+// Hints must be defined before the trait; pgo.sh generates them from a
+// TRAIT_TRACE profile (trait_trace_dump_pgo).  Undefined hints cost nothing.
+// TRAIT_HINT_HIT(Fn), if defined before the first #include "trait.h", runs
+// each time a guard matches and Fn is called directly (e.g. to count hits).
+// -----------------------------------------------------------------------------
+#ifndef TRAIT_HINT_HIT
+#define TRAIT_HINT_HIT(Fn) ((void)0)
+#endif
+#define ___TRAIT_HINT_PROBE(...) ___TRAIT_PROBE()
+#define ___TRAIT_HINT_ID(Fn) Fn
+#define ___TRAIT_HINT_GUARD(Hint, Slot, Args)                                      \
+  glue(___TRAIT_HINT_GUARD_, ___TRAIT_CHECK(___TRAIT_HINT_PROBE Hint))(Hint, Slot, Args)
+#define ___TRAIT_HINT_GUARD_0(Hint, Slot, Args) ((void)0)
+#define ___TRAIT_HINT_GUARD_1(Hint, Slot, Args)                                    \
+  ___TRAIT_HINT_GUARD_FN(Slot, Args, ___TRAIT_HINT_ID Hint)
+#define ___TRAIT_HINT_GUARD_FN(Slot, Args, Fn) ___TRAIT_HINT_GUARD_FN_(Slot, Args, Fn)
+#define ___TRAIT_HINT_GUARD_FN_(Slot, Args, Fn)                                    \
+  do {                                                                             \
+    extern ___TRAIT_TYPEOF(*Slot) glue(___trait_hint_, Fn)                         \
+        __asm__(___TRAIT_STR(__USER_LABEL_PREFIX__) #Fn);                          \
+    if (__builtin_expect(Slot == glue(___trait_hint_, Fn), 1)) {                   \
+      TRAIT_HINT_HIT(Fn);                                                          \
+      ___TRAIT_RETURN(glue(___trait_hint_, Fn) Args);                              \
+    }                                                                              \
+  } while (0)
 
 // -----------------------------------------------------------------------------
 // DYNSDREG: DynTraitname wrapper function emitters
@@ -1931,110 +3484,172 @@ extern struct ERROR_type_not_impl_for_this_trait ERROR_type_not_impl_for_this_tr
 // Like SDREG but:
 //   - Parameter is DynImpl* (or const DynImpl*) instead of For*
 //   - Body calls self->vt->Name(self->self, ...) instead of For_Impl_Name()
+// The object type and vtable member come from ___TRAIT_DYNSD_SELF and
+// ___TRAIT_DYNSD_VT, so the same emitters serve multi-trait objects.
 // -----------------------------------------------------------------------------
 
 // ── non-void return ─────────────────────────────────────────────────────────
-#define ___TRAIT_DYNSDREG_0_00(Ret, Name)                                        \
+#define ___TRAIT_DYNSDREG_0_00(Ret, Hint, Name)                                \
   ___TRAIT_UNUSED static inline Ret ___TRAIT_SDREG_FN(                             \
-      glue(Dyn, Impl) *self) {                                                 \
-    ___TRAIT_RETURN(self->vt->Name(self->self));                                     \
+      ___TRAIT_DYNSD_SELF *self) {                                                 \
+    ___TRAIT_PROF_HIT(1, ___TRAIT_DYNSD_SELF, Impl, Name);                       \
+    ___TRAIT_TRACE_HIT(___TRAIT_DYNSD_SELF, Impl, Name, self->___TRAIT_DYNSD_VT);  \
+    ___TRAIT_HINT_GUARD(Hint, self->___TRAIT_DYNSD_VT->Name, (self->self));    \
+    ___TRAIT_RETURN(self->___TRAIT_DYNSD_VT->Name(self->self));                                     \
   }
-#define ___TRAIT_DYNSDREG_0_10(Ret, Name)                                        \
+#define ___TRAIT_DYNSDREG_0_10(Ret, Hint, Name)                                \
   ___TRAIT_UNUSED static inline Ret ___TRAIT_SDREG_FN(                             \
-      const glue(Dyn, Impl) *self) {                                           \
-    ___TRAIT_RETURN(self->vt->Name(self->self));                                     \
+      const ___TRAIT_DYNSD_SELF *self) {                                           \
+    ___TRAIT_PROF_HIT(1, ___TRAIT_DYNSD_SELF, Impl, Name);                       \
+    ___TRAIT_TRACE_HIT(___TRAIT_DYNSD_SELF, Impl, Name, self->___TRAIT_DYNSD_VT);  \
+    ___TRAIT_HINT_GUARD(Hint, self->___TRAIT_DYNSD_VT->Name, (self->self));    \
+    ___TRAIT_RETURN(self->___TRAIT_DYNSD_VT->Name(self->self));                                     \
   }
-#define ___TRAIT_DYNSDREG_0_01(Ret, Name, T1)                                    \
+#define ___TRAIT_DYNSDREG_0_01(Ret, Hint, Name, T1)                            \
   ___TRAIT_UNUSED static inline Ret ___TRAIT_SDREG_FN(                             \
-      glue(Dyn, Impl) *self, T1 a1) {                                          \
-    ___TRAIT_RETURN(self->vt->Name(self->self, a1));                                 \
+      ___TRAIT_DYNSD_SELF *self, T1 a1) {                                          \
+    ___TRAIT_PROF_HIT(1, ___TRAIT_DYNSD_SELF, Impl, Name);                       \
+    ___TRAIT_TRACE_HIT(___TRAIT_DYNSD_SELF, Impl, Name, self->___TRAIT_DYNSD_VT);  \
+    ___TRAIT_HINT_GUARD(Hint, self->___TRAIT_DYNSD_VT->Name, (self->self, a1)); \
+    ___TRAIT_RETURN(self->___TRAIT_DYNSD_VT->Name(self->self, a1));                                 \
   }
-#define ___TRAIT_DYNSDREG_0_11(Ret, Name, T1)                                    \
+#define ___TRAIT_DYNSDREG_0_11(Ret, Hint, Name, T1)                            \
   ___TRAIT_UNUSED static inline Ret ___TRAIT_SDREG_FN(                             \
-      const glue(Dyn, Impl) *self, T1 a1) {                                    \
-    ___TRAIT_RETURN(self->vt->Name(self->self, a1));                                 \
+      const ___TRAIT_DYNSD_SELF *self, T1 a1) {                                    \
+    ___TRAIT_PROF_HIT(1, ___TRAIT_DYNSD_SELF, Impl, Name);                       \
+    ___TRAIT_TRACE_HIT(___TRAIT_DYNSD_SELF, Impl, Name, self->___TRAIT_DYNSD_VT);  \
+    ___TRAIT_HINT_GUARD(Hint, self->___TRAIT_DYNSD_VT->Name, (self->self, a1)); \
+    ___TRAIT_RETURN(self->___TRAIT_DYNSD_VT->Name(self->self, a1));                                 \
   }
-#define ___TRAIT_DYNSDREG_0_02(Ret, Name, T1, T2)                                \
+#define ___TRAIT_DYNSDREG_0_02(Ret, Hint, Name, T1, T2)                        \
   ___TRAIT_UNUSED static inline Ret ___TRAIT_SDREG_FN(                             \
-      glue(Dyn, Impl) *self, T1 a1, T2 a2) {                                   \
-    ___TRAIT_RETURN(self->vt->Name(self->self, a1, a2));                             \
+      ___TRAIT_DYNSD_SELF *self, T1 a1, T2 a2) {                                   \
+    ___TRAIT_PROF_HIT(1, ___TRAIT_DYNSD_SELF, Impl, Name);                       \
+    ___TRAIT_TRACE_HIT(___TRAIT_DYNSD_SELF, Impl, Name, self->___TRAIT_DYNSD_VT);  \
+    ___TRAIT_HINT_GUARD(Hint, self->___TRAIT_DYNSD_VT->Name, (self->self, a1, a2)); \
+    ___TRAIT_RETURN(self->___TRAIT_DYNSD_VT->Name(self->self, a1, a2));                             \
   }
-#define ___TRAIT_DYNSDREG_0_12(Ret, Name, T1, T2)                                \
+#define ___TRAIT_DYNSDREG_0_12(Ret, Hint, Name, T1, T2)                        \
   ___TRAIT_UNUSED static inline Ret ___TRAIT_SDREG_FN(                             \
-      const glue(Dyn, Impl) *self, T1 a1, T2 a2) {                             \
-    ___TRAIT_RETURN(self->vt->Name(self->self, a1, a2));                             \
+      const ___TRAIT_DYNSD_SELF *self, T1 a1, T2 a2) {                             \
+    ___TRAIT_PROF_HIT(1, ___TRAIT_DYNSD_SELF, Impl, Name);                       \
+    ___TRAIT_TRACE_HIT(___TRAIT_DYNSD_SELF, Impl, Name, self->___TRAIT_DYNSD_VT);  \
+    ___TRAIT_HINT_GUARD(Hint, self->___TRAIT_DYNSD_VT->Name, (self->self, a1, a2)); \
+    ___TRAIT_RETURN(self->___TRAIT_DYNSD_VT->Name(self->self, a1, a2));                             \
   }
-#define ___TRAIT_DYNSDREG_0_03(Ret, Name, T1, T2, T3)                            \
+#define ___TRAIT_DYNSDREG_0_03(Ret, Hint, Name, T1, T2, T3)                    \
   ___TRAIT_UNUSED static inline Ret ___TRAIT_SDREG_FN(                             \
-      glue(Dyn, Impl) *self, T1 a1, T2 a2, T3 a3) {                            \
-    ___TRAIT_RETURN(self->vt->Name(self->self, a1, a2, a3));                         \
+      ___TRAIT_DYNSD_SELF *self, T1 a1, T2 a2, T3 a3) {                            \
+    ___TRAIT_PROF_HIT(1, ___TRAIT_DYNSD_SELF, Impl, Name);                       \
+    ___TRAIT_TRACE_HIT(___TRAIT_DYNSD_SELF, Impl, Name, self->___TRAIT_DYNSD_VT);  \
+    ___TRAIT_HINT_GUARD(Hint, self->___TRAIT_DYNSD_VT->Name, (self->self, a1, a2, a3)); \
+    ___TRAIT_RETURN(self->___TRAIT_DYNSD_VT->Name(self->self, a1, a2, a3));                         \
   }
-#define ___TRAIT_DYNSDREG_0_13(Ret, Name, T1, T2, T3)                            \
+#define ___TRAIT_DYNSDREG_0_13(Ret, Hint, Name, T1, T2, T3)                    \
   ___TRAIT_UNUSED static inline Ret ___TRAIT_SDREG_FN(                             \
-      const glue(Dyn, Impl) *self, T1 a1, T2 a2, T3 a3) {                      \
-    ___TRAIT_RETURN(self->vt->Name(self->self, a1, a2, a3));                         \
+      const ___TRAIT_DYNSD_SELF *self, T1 a1, T2 a2, T3 a3) {                      \
+    ___TRAIT_PROF_HIT(1, ___TRAIT_DYNSD_SELF, Impl, Name);                       \
+    ___TRAIT_TRACE_HIT(___TRAIT_DYNSD_SELF, Impl, Name, self->___TRAIT_DYNSD_VT);  \
+    ___TRAIT_HINT_GUARD(Hint, self->___TRAIT_DYNSD_VT->Name, (self->self, a1, a2, a3)); \
+    ___TRAIT_RETURN(self->___TRAIT_DYNSD_VT->Name(self->self, a1, a2, a3));                         \
   }
-#define ___TRAIT_DYNSDREG_0_04(Ret, Name, T1, T2, T3, T4)                        \
+#define ___TRAIT_DYNSDREG_0_04(Ret, Hint, Name, T1, T2, T3, T4)                \
   ___TRAIT_UNUSED static inline Ret ___TRAIT_SDREG_FN(                             \
-      glue(Dyn, Impl) *self, T1 a1, T2 a2, T3 a3, T4 a4) {                     \
-    ___TRAIT_RETURN(self->vt->Name(self->self, a1, a2, a3, a4));                     \
+      ___TRAIT_DYNSD_SELF *self, T1 a1, T2 a2, T3 a3, T4 a4) {                     \
+    ___TRAIT_PROF_HIT(1, ___TRAIT_DYNSD_SELF, Impl, Name);                       \
+    ___TRAIT_TRACE_HIT(___TRAIT_DYNSD_SELF, Impl, Name, self->___TRAIT_DYNSD_VT);  \
+    ___TRAIT_HINT_GUARD(Hint, self->___TRAIT_DYNSD_VT->Name, (self->self, a1, a2, a3, a4)); \
+    ___TRAIT_RETURN(self->___TRAIT_DYNSD_VT->Name(self->self, a1, a2, a3, a4));                     \
   }
-#define ___TRAIT_DYNSDREG_0_14(Ret, Name, T1, T2, T3, T4)                        \
+#define ___TRAIT_DYNSDREG_0_14(Ret, Hint, Name, T1, T2, T3, T4)                \
   ___TRAIT_UNUSED static inline Ret ___TRAIT_SDREG_FN(                             \
-      const glue(Dyn, Impl) *self, T1 a1, T2 a2, T3 a3, T4 a4) {               \
-    ___TRAIT_RETURN(self->vt->Name(self->self, a1, a2, a3, a4));                     \
+      const ___TRAIT_DYNSD_SELF *self, T1 a1, T2 a2, T3 a3, T4 a4) {               \
+    ___TRAIT_PROF_HIT(1, ___TRAIT_DYNSD_SELF, Impl, Name);                       \
+    ___TRAIT_TRACE_HIT(___TRAIT_DYNSD_SELF, Impl, Name, self->___TRAIT_DYNSD_VT);  \
+    ___TRAIT_HINT_GUARD(Hint, self->___TRAIT_DYNSD_VT->Name, (self->self, a1, a2, a3, a4)); \
+    ___TRAIT_RETURN(self->___TRAIT_DYNSD_VT->Name(self->self, a1, a2, a3, a4));                     \
   }
 
 // ── void return ─────────────────────────────────────────────────────────────
-#define ___TRAIT_DYNSDREG_1_00(Ret, Name)                                        \
+#define ___TRAIT_DYNSDREG_1_00(Ret, Hint, Name)                                \
   ___TRAIT_UNUSED static inline void ___TRAIT_SDREG_FN(                            \
-      glue(Dyn, Impl) *self) {                                                  \
-    self->vt->Name(self->self);                                                \
+      ___TRAIT_DYNSD_SELF *self) {                                                  \
+    ___TRAIT_PROF_HIT(1, ___TRAIT_DYNSD_SELF, Impl, Name);                       \
+    ___TRAIT_TRACE_HIT(___TRAIT_DYNSD_SELF, Impl, Name, self->___TRAIT_DYNSD_VT);  \
+    ___TRAIT_HINT_GUARD(Hint, self->___TRAIT_DYNSD_VT->Name, (self->self));    \
+    self->___TRAIT_DYNSD_VT->Name(self->self);                                                \
   }
-#define ___TRAIT_DYNSDREG_1_10(Ret, Name)                                        \
+#define ___TRAIT_DYNSDREG_1_10(Ret, Hint, Name)                                \
   ___TRAIT_UNUSED static inline void ___TRAIT_SDREG_FN(                            \
-      const glue(Dyn, Impl) *self) {                                            \
-    self->vt->Name(self->self);                                                \
+      const ___TRAIT_DYNSD_SELF *self) {                                            \
+    ___TRAIT_PROF_HIT(1, ___TRAIT_DYNSD_SELF, Impl, Name);                       \
+    ___TRAIT_TRACE_HIT(___TRAIT_DYNSD_SELF, Impl, Name, self->___TRAIT_DYNSD_VT);  \
+    ___TRAIT_HINT_GUARD(Hint, self->___TRAIT_DYNSD_VT->Name, (self->self));    \
+    self->___TRAIT_DYNSD_VT->Name(self->self);                                                \
   }
-#define ___TRAIT_DYNSDREG_1_01(Ret, Name, T1)                                    \
+#define ___TRAIT_DYNSDREG_1_01(Ret, Hint, Name, T1)                            \
   ___TRAIT_UNUSED static inline void ___TRAIT_SDREG_FN(                            \
-      glue(Dyn, Impl) *self, T1 a1) {                                           \
-    self->vt->Name(self->self, a1);                                            \
+      ___TRAIT_DYNSD_SELF *self, T1 a1) {                                           \
+    ___TRAIT_PROF_HIT(1, ___TRAIT_DYNSD_SELF, Impl, Name);                       \
+    ___TRAIT_TRACE_HIT(___TRAIT_DYNSD_SELF, Impl, Name, self->___TRAIT_DYNSD_VT);  \
+    ___TRAIT_HINT_GUARD(Hint, self->___TRAIT_DYNSD_VT->Name, (self->self, a1)); \
+    self->___TRAIT_DYNSD_VT->Name(self->self, a1);                                            \
   }
-#define ___TRAIT_DYNSDREG_1_11(Ret, Name, T1)                                    \
+#define ___TRAIT_DYNSDREG_1_11(Ret, Hint, Name, T1)                            \
   ___TRAIT_UNUSED static inline void ___TRAIT_SDREG_FN(                            \
-      const glue(Dyn, Impl) *self, T1 a1) {                                     \
-    self->vt->Name(self->self, a1);                                            \
+      const ___TRAIT_DYNSD_SELF *self, T1 a1) {                                     \
+    ___TRAIT_PROF_HIT(1, ___TRAIT_DYNSD_SELF, Impl, Name);                       \
+    ___TRAIT_TRACE_HIT(___TRAIT_DYNSD_SELF, Impl, Name, self->___TRAIT_DYNSD_VT);  \
+    ___TRAIT_HINT_GUARD(Hint, self->___TRAIT_DYNSD_VT->Name, (self->self, a1)); \
+    self->___TRAIT_DYNSD_VT->Name(self->self, a1);                                            \
   }
-#define ___TRAIT_DYNSDREG_1_02(Ret, Name, T1, T2)                                \
+#define ___TRAIT_DYNSDREG_1_02(Ret, Hint, Name, T1, T2)                        \
   ___TRAIT_UNUSED static inline void ___TRAIT_SDREG_FN(                            \
-      glue(Dyn, Impl) *self, T1 a1, T2 a2) {                                    \
-    self->vt->Name(self->self, a1, a2);                                        \
+      ___TRAIT_DYNSD_SELF *self, T1 a1, T2 a2) {                                    \
+    ___TRAIT_PROF_HIT(1, ___TRAIT_DYNSD_SELF, Impl, Name);                       \
+    ___TRAIT_TRACE_HIT(___TRAIT_DYNSD_SELF, Impl, Name, self->___TRAIT_DYNSD_VT);  \
+    ___TRAIT_HINT_GUARD(Hint, self->___TRAIT_DYNSD_VT->Name, (self->self, a1, a2)); \
+    self->___TRAIT_DYNSD_VT->Name(self->self, a1, a2);                                        \
   }
-#define ___TRAIT_DYNSDREG_1_12(Ret, Name, T1, T2)                                \
+#define ___TRAIT_DYNSDREG_1_12(Ret, Hint, Name, T1, T2)                        \
   ___TRAIT_UNUSED static inline void ___TRAIT_SDREG_FN(                            \
-      const glue(Dyn, Impl) *self, T1 a1, T2 a2) {                              \
-    self->vt->Name(self->self, a1, a2);                                        \
+      const ___TRAIT_DYNSD_SELF *self, T1 a1, T2 a2) {                              \
+    ___TRAIT_PROF_HIT(1, ___TRAIT_DYNSD_SELF, Impl, Name);                       \
+    ___TRAIT_TRACE_HIT(___TRAIT_DYNSD_SELF, Impl, Name, self->___TRAIT_DYNSD_VT);  \
+    ___TRAIT_HINT_GUARD(Hint, self->___TRAIT_DYNSD_VT->Name, (self->self, a1, a2)); \
+    self->___TRAIT_DYNSD_VT->Name(self->self, a1, a2);                                        \
   }
-#define ___TRAIT_DYNSDREG_1_03(Ret, Name, T1, T2, T3)                            \
+#define ___TRAIT_DYNSDREG_1_03(Ret, Hint, Name, T1, T2, T3)                    \
   ___TRAIT_UNUSED static inline void ___TRAIT_SDREG_FN(                            \
-      glue(Dyn, Impl) *self, T1 a1, T2 a2, T3 a3) {                             \
-    self->vt->Name(self->self, a1, a2, a3);                                    \
+      ___TRAIT_DYNSD_SELF *self, T1 a1, T2 a2, T3 a3) {                             \
+    ___TRAIT_PROF_HIT(1, ___TRAIT_DYNSD_SELF, Impl, Name);                       \
+    ___TRAIT_TRACE_HIT(___TRAIT_DYNSD_SELF, Impl, Name, self->___TRAIT_DYNSD_VT);  \
+    ___TRAIT_HINT_GUARD(Hint, self->___TRAIT_DYNSD_VT->Name, (self->self, a1, a2, a3)); \
+    self->___TRAIT_DYNSD_VT->Name(self->self, a1, a2, a3);                                    \
   }
-#define ___TRAIT_DYNSDREG_1_13(Ret, Name, T1, T2, T3)                            \
+#define ___TRAIT_DYNSDREG_1_13(Ret, Hint, Name, T1, T2, T3)                    \
   ___TRAIT_UNUSED static inline void ___TRAIT_SDREG_FN(                            \
-      const glue(Dyn, Impl) *self, T1 a1, T2 a2, T3 a3) {                       \
-    self->vt->Name(self->self, a1, a2, a3);                                    \
+      const ___TRAIT_DYNSD_SELF *self, T1 a1, T2 a2, T3 a3) {                       \
+    ___TRAIT_PROF_HIT(1, ___TRAIT_DYNSD_SELF, Impl, Name);                       \
+    ___TRAIT_TRACE_HIT(___TRAIT_DYNSD_SELF, Impl, Name, self->___TRAIT_DYNSD_VT);  \
+    ___TRAIT_HINT_GUARD(Hint, self->___TRAIT_DYNSD_VT->Name, (self->self, a1, a2, a3)); \
+    self->___TRAIT_DYNSD_VT->Name(self->self, a1, a2, a3);                                    \
   }
-#define ___TRAIT_DYNSDREG_1_04(Ret, Name, T1, T2, T3, T4)                        \
+#define ___TRAIT_DYNSDREG_1_04(Ret, Hint, Name, T1, T2, T3, T4)                \
   ___TRAIT_UNUSED static inline void ___TRAIT_SDREG_FN(                            \
-      glue(Dyn, Impl) *self, T1 a1, T2 a2, T3 a3, T4 a4) {                      \
-    self->vt->Name(self->self, a1, a2, a3, a4);                                \
+      ___TRAIT_DYNSD_SELF *self, T1 a1, T2 a2, T3 a3, T4 a4) {                      \
+    ___TRAIT_PROF_HIT(1, ___TRAIT_DYNSD_SELF, Impl, Name);                       \
+    ___TRAIT_TRACE_HIT(___TRAIT_DYNSD_SELF, Impl, Name, self->___TRAIT_DYNSD_VT);  \
+    ___TRAIT_HINT_GUARD(Hint, self->___TRAIT_DYNSD_VT->Name, (self->self, a1, a2, a3, a4)); \
+    self->___TRAIT_DYNSD_VT->Name(self->self, a1, a2, a3, a4);                                \
   }
-#define ___TRAIT_DYNSDREG_1_14(Ret, Name, T1, T2, T3, T4)                        \
+#define ___TRAIT_DYNSDREG_1_14(Ret, Hint, Name, T1, T2, T3, T4)                \
   ___TRAIT_UNUSED static inline void ___TRAIT_SDREG_FN(                            \
-      const glue(Dyn, Impl) *self, T1 a1, T2 a2, T3 a3, T4 a4) {                \
-    self->vt->Name(self->self, a1, a2, a3, a4);                                \
+      const ___TRAIT_DYNSD_SELF *self, T1 a1, T2 a2, T3 a3, T4 a4) {                \
+    ___TRAIT_PROF_HIT(1, ___TRAIT_DYNSD_SELF, Impl, Name);                       \
+    ___TRAIT_TRACE_HIT(___TRAIT_DYNSD_SELF, Impl, Name, self->___TRAIT_DYNSD_VT);  \
+    ___TRAIT_HINT_GUARD(Hint, self->___TRAIT_DYNSD_VT->Name, (self->self, a1, a2, a3, a4)); \
+    self->___TRAIT_DYNSD_VT->Name(self->self, a1, a2, a3, a4);                                \
   }
 
 // =============================================================================
@@ -2062,6 +3677,39 @@ extern struct ERROR_type_not_impl_for_this_trait ERROR_type_not_impl_for_this_tr
 #define ___TRAIT_TT_C5 0
 #define ___TRAIT_TT_C6 0
 
+// =============================================================================
+// Registry statistics
+//
+// TRAIT_SD_SLOTS and TRAIT_TT_SLOTS are the SD and TT slots used so far in
+// this TU, as integer constant expressions (also valid in #if).  Every call()
+// expands a _Generic chain that grows with TRAIT_SD_SLOTS, and every dyn() one
+// that grows with TRAIT_TT_SLOTS, so they double as compile-time budgets:
+//   #if TRAIT_SD_SLOTS > 400
+//   #error "call() chains in this TU are getting long"
+//   #endif
+// Per trait, as enum constants:
+//   trait_methods(T)    methods of T, inherited ones included
+//   trait_dyn_slots(T)  SD slots taken by T's DynSD wrappers (0 if static)
+// -DTRAIT_STATS adds a #pragma message per trait and impl with the counters,
+// labelled "(octal)": they are kept as octal digits, and a pragma string
+// cannot do arithmetic.  "SD slots 00000011 (octal)" is 9 slots.
+// =============================================================================
+#define TRAIT_SD_SLOTS                                                             \
+  (___TRAIT_SD_C1 + 8 * ___TRAIT_SD_C2 + 64 * ___TRAIT_SD_C3 +                    \
+   512 * ___TRAIT_SD_C4 + 4096 * ___TRAIT_SD_C5 + 32768 * ___TRAIT_SD_C6 +          \
+   262144 * ___TRAIT_SD_C7)
+#define TRAIT_TT_SLOTS                                                             \
+  (___TRAIT_TT_C1 + 8 * ___TRAIT_TT_C2 + 64 * ___TRAIT_TT_C3 +                    \
+   512 * ___TRAIT_TT_C4 + 4096 * ___TRAIT_TT_C5 + 32768 * ___TRAIT_TT_C6)
+#define trait_methods(T) glue(T, ___methods)
+#define trait_dyn_slots(T) glue(T, ___dyn_slots)
+#define ___TRAIT_SD_OCTAL                                                          \
+  ___TRAIT_STR(glue8(0, ___TRAIT_SD_C7, ___TRAIT_SD_C6, ___TRAIT_SD_C5,            \
+                     ___TRAIT_SD_C4, ___TRAIT_SD_C3, ___TRAIT_SD_C2, ___TRAIT_SD_C1))
+#define ___TRAIT_TT_OCTAL                                                          \
+  ___TRAIT_STR(glue7(0, ___TRAIT_TT_C6, ___TRAIT_TT_C5, ___TRAIT_TT_C4,            \
+                     ___TRAIT_TT_C3, ___TRAIT_TT_C2, ___TRAIT_TT_C1))
+
 // =============================================================================
 // SD dispatch: _Generic-based (standard C11)
 //
@@ -2448,6 +4096,31 @@ extern struct ERROR_trait_not_implemented_for_this_type ERROR_trait_not_implemen
       default: ERROR_trait_not_implemented_for_this_type                          \
   )(obj, ##__VA_ARGS__)
 
+// ── call_generic(G, obj, ...) ───────────────────────────────────────────────
+//
+// Calls G_T(obj, ...), the copy of generic algorithm G stamped for T = the
+// type of *obj (see <Trait>Generics).  Resolved like call(): the selector is
+// a null struct ___trait_generic_G *, registered by each stamped copy.
+#define call_generic(G, ...) call((struct glue(___trait_generic_, G) *)0, __VA_ARGS__)
+
+// ── implements(Type, Trait) / if_impl(Trait, ptr, then, else) ──────────────
+//
+// implements is an integer constant expression: 1 if an impl block of Trait
+// for Type came before this point, else 0 (IMPLS fails to compile instead).
+// Every impl registers the SD pair (Trait___sel_t, Type) with the constant 1.
+// if_impl selects then_expr when *ptr's type implements Trait and else_expr
+// otherwise; the other expression is type-checked but never evaluated, so
+// generic code can take a fast path for types that have one:
+//   if_impl(Contiguous, arr, memcpy(dst, arr, n * sizeof *arr), copy_each(dst, arr, n))
+#define implements(Type, Trait)                                                   \
+  _Generic((void (*)(glue(Trait, ___sel_t), Type))0,                              \
+      ___TRAIT_SD_SLOTS                                                           \
+      default: 0)
+#define if_impl(Trait, ptr, then_expr, else_expr)                                 \
+  _Generic((char (*)[1 + implements(___TRAIT_TYPEOF(*(ptr)), Trait)])0,           \
+      char (*)[2]: (then_expr),                                                   \
+      default: (else_expr))
+
 // =============================================================================
 // C23 overrides
 //
@@ -2535,6 +4208,18 @@ extern struct ERROR_trait_not_implemented_for_this_type ERROR_trait_not_implemen
 #undef  ___TRAIT_ACT_DMLISTV_DEFAULT_1
 #define ___TRAIT_ACT_DMLISTV_DEFAULT_1(Type, Ret, Name, ...)                      \
   , (Type, 1, Ret, ___TRAIT_VT, Name __VA_OPT__(,) __VA_ARGS__)
+#undef  ___TRAIT_ACT_DMLISTP_REQUIRE_0
+#define ___TRAIT_ACT_DMLISTP_REQUIRE_0(Type, Ret, Name, ...)                      \
+  , (Type, 0, Ret, ___TRAIT_VTP, Name __VA_OPT__(,) __VA_ARGS__)
+#undef  ___TRAIT_ACT_DMLISTP_REQUIRE_1
+#define ___TRAIT_ACT_DMLISTP_REQUIRE_1(Type, Ret, Name, ...)                      \
+  , (Type, 1, Ret, ___TRAIT_VTP, Name __VA_OPT__(,) __VA_ARGS__)
+#undef  ___TRAIT_ACT_DMLISTP_DEFAULT_0
+#define ___TRAIT_ACT_DMLISTP_DEFAULT_0(Type, Ret, Name, ...)                      \
+  , (Type, 0, Ret, ___TRAIT_VTP, Name __VA_OPT__(,) __VA_ARGS__)
+#undef  ___TRAIT_ACT_DMLISTP_DEFAULT_1
+#define ___TRAIT_ACT_DMLISTP_DEFAULT_1(Type, Ret, Name, ...)                      \
+  , (Type, 1, Ret, ___TRAIT_VTP, Name __VA_OPT__(,) __VA_ARGS__)
 
 
 // ── BIND actions (vtable initializer) ─────────────────────────────────────────
@@ -2604,11 +4289,10 @@ extern struct ERROR_trait_not_implemented_for_this_type ERROR_trait_not_implemen
   typedef glue5(___sel_, NameSignature, _, Name, _t) glue8(                           \
       ___trait_sd_, ___TRAIT_SD_C6, ___TRAIT_SD_C5, ___TRAIT_SD_C4, ___TRAIT_SD_C3, ___TRAIT_SD_C2, ___TRAIT_SD_C1, _sty);               \
   typedef void (*glue8(___trait_sd_pair_, ___TRAIT_SD_C6, ___TRAIT_SD_C5, ___TRAIT_SD_C4, ___TRAIT_SD_C3, ___TRAIT_SD_C2, ___TRAIT_SD_C1, _p))(glue5(___sel_, NameSignature, _, Name, _t), For); \
+  ___TRAIT_SYMMAP(___TRAIT_SDREG_FN, For, NameSignature, Name, static)           \
   glue5(___TRAIT_SDREG_, 0, _, ConstFlag,                                            \
         ___TRAIT_NARG(__VA_ARGS__))(NameSignature, Ret, Name __VA_OPT__(,) __VA_ARGS__)
 
-#undef  ___TRAIT_DYNSD_EMIT
-#define ___TRAIT_DYNSD_EMIT(tuple) ___TRAIT_DYNSD_EMIT_D tuple
 #undef  ___TRAIT_DYNSD_EMIT_D
 #define ___TRAIT_DYNSD_EMIT_D(NameSignature, ConstFlag, Ret, T4, ...)                \
   glue(___TRAIT_DYNSD_EMIT_,                                                         \
@@ -2618,25 +4302,27 @@ extern struct ERROR_trait_not_implemented_for_this_type ERROR_trait_not_implemen
 // Own method tuple: (NameSignature, ConstFlag, Ret, Name, ExtraArgs...)
 #undef  ___TRAIT_DYNSD_EMIT_0
 #define ___TRAIT_DYNSD_EMIT_0(NameSignature, ConstFlag, Ret, Name, ...)              \
-  typedef glue(Dyn, Impl) glue8(___trait_sd_, ___TRAIT_SD_C6, ___TRAIT_SD_C5,       \
+  typedef ___TRAIT_DYNSD_SELF glue8(___trait_sd_, ___TRAIT_SD_C6, ___TRAIT_SD_C5,       \
                                   ___TRAIT_SD_C4, ___TRAIT_SD_C3, ___TRAIT_SD_C2, ___TRAIT_SD_C1, _ty);  \
   typedef glue5(___sel_, NameSignature, _, Name, _t) glue8(                           \
       ___trait_sd_, ___TRAIT_SD_C6, ___TRAIT_SD_C5, ___TRAIT_SD_C4, ___TRAIT_SD_C3, ___TRAIT_SD_C2, ___TRAIT_SD_C1, _sty);               \
-  typedef void (*glue8(___trait_sd_pair_, ___TRAIT_SD_C6, ___TRAIT_SD_C5, ___TRAIT_SD_C4, ___TRAIT_SD_C3, ___TRAIT_SD_C2, ___TRAIT_SD_C1, _p))(glue5(___sel_, NameSignature, _, Name, _t), glue(Dyn, Impl)); \
+  typedef void (*glue8(___trait_sd_pair_, ___TRAIT_SD_C6, ___TRAIT_SD_C5, ___TRAIT_SD_C4, ___TRAIT_SD_C3, ___TRAIT_SD_C2, ___TRAIT_SD_C1, _p))(glue5(___sel_, NameSignature, _, Name, _t), ___TRAIT_DYNSD_SELF); \
+  ___TRAIT_SYMMAP(___TRAIT_SDREG_FN, ___TRAIT_DYNSD_SELF, Impl, Name, dyn)       \
   glue5(___TRAIT_DYNSDREG_, 0, _, ConstFlag,                                         \
-        ___TRAIT_NARG(__VA_ARGS__))(Ret, Name __VA_OPT__(,) __VA_ARGS__)
+        ___TRAIT_NARG(__VA_ARGS__))(Ret, glue4(Hint_, Impl, _, Name), Name __VA_OPT__(,) __VA_ARGS__)
 
 // Replayed base method tuple:
 // (NameSignature, ConstFlag, Ret, ___TRAIT_VT, Name, ExtraArgs...)
 #undef  ___TRAIT_DYNSD_EMIT_1
 #define ___TRAIT_DYNSD_EMIT_1(NameSignature, ConstFlag, Ret, VT, Name, ...)          \
-  typedef glue(Dyn, Impl) glue8(___trait_sd_, ___TRAIT_SD_C6, ___TRAIT_SD_C5,       \
+  typedef ___TRAIT_DYNSD_SELF glue8(___trait_sd_, ___TRAIT_SD_C6, ___TRAIT_SD_C5,       \
                                   ___TRAIT_SD_C4, ___TRAIT_SD_C3, ___TRAIT_SD_C2, ___TRAIT_SD_C1, _ty);  \
   typedef glue5(___sel_, NameSignature, _, Name, _t) glue8(                           \
       ___trait_sd_, ___TRAIT_SD_C6, ___TRAIT_SD_C5, ___TRAIT_SD_C4, ___TRAIT_SD_C3, ___TRAIT_SD_C2, ___TRAIT_SD_C1, _sty);               \
-  typedef void (*glue8(___trait_sd_pair_, ___TRAIT_SD_C6, ___TRAIT_SD_C5, ___TRAIT_SD_C4, ___TRAIT_SD_C3, ___TRAIT_SD_C2, ___TRAIT_SD_C1, _p))(glue5(___sel_, NameSignature, _, Name, _t), glue(Dyn, Impl)); \
+  typedef void (*glue8(___trait_sd_pair_, ___TRAIT_SD_C6, ___TRAIT_SD_C5, ___TRAIT_SD_C4, ___TRAIT_SD_C3, ___TRAIT_SD_C2, ___TRAIT_SD_C1, _p))(glue5(___sel_, NameSignature, _, Name, _t), ___TRAIT_DYNSD_SELF); \
+  ___TRAIT_SYMMAP(___TRAIT_SDREG_FN, ___TRAIT_DYNSD_SELF, Impl, NameSignature.Name, dyn)\
   glue5(___TRAIT_DYNSDREG_, 0, _, ConstFlag,                                         \
-        ___TRAIT_NARG(__VA_ARGS__))(Ret, NameSignature.Name __VA_OPT__(,) __VA_ARGS__)
+        ___TRAIT_NARG(__VA_ARGS__))(Ret, glue4(Hint_, NameSignature, _, Name), ___TRAIT_VT_FIELD(VT, NameSignature, Name) __VA_OPT__(,) __VA_ARGS__)
 
 // ── def / constdef ────────────────────────────────────────────────────────────
 #undef  def
@@ -2683,6 +4369,11 @@ extern struct ERROR_trait_not_implemented_for_this_type ERROR_trait_not_implemen
 // =============================================================================
 #if ___TRAIT_CE
 
+// Upcast duplicate detection without _Generic.
+#undef  ___TRAIT_UP_SAME
+#define ___TRAIT_UP_SAME(t, a)                                                     \
+  __builtin_types_compatible_p(___TRAIT_UP_TYPE(t), ___TRAIT_UP_TYPE(a))
+
 // Controlling type for call(sel, obj): matches ___trait_sd_pair_* typedefs.
 #define ___TRAIT_CE_CTYPE(sel, obj) \
   void (*)(___TRAIT_TYPEOF(sel), ___TRAIT_TYPEOF(*(obj)))
@@ -2987,6 +4678,17 @@ extern struct ERROR_trait_not_implemented_for_this_type ERROR_trait_not_implemen
    ERROR_type_not_impl_for_this_trait                                             \
    ___TRAIT_TT_CE_CLOSES)(ptr)
 
+#undef  implements
+#define implements(Type, Trait)                                                   \
+  (___TRAIT_SD_CE_SLOTS(void (*)(glue(Trait, ___sel_t), Type))                    \
+   0                                                                              \
+   ___TRAIT_SD_CE_CLOSES)
+
+#undef  if_impl
+#define if_impl(Trait, ptr, then_expr, else_expr)                                 \
+  __builtin_choose_expr(implements(___TRAIT_TYPEOF(*(ptr)), Trait),               \
+                        then_expr, else_expr)
+
 #endif // ___TRAIT_CE
 
 // ── IMPLS(Type, Trait) ──────────────────────────────────────────────────────
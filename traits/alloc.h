@@ -0,0 +1,268 @@
+// clang-format off
+// =============================================================================
+// traits/alloc.h — static Allocator trait: system, bump arena, fixed-size pool
+//
+//   #include "traits/alloc.h"
+//
+//   ArenaAlloc arena = {0};                          // grows in malloc'd chunks
+//   Msg *m = call(Allocator.alloc, &arena, sizeof *m);  // inlines to a bump
+//   call(Allocator.reset, &arena);                   // everything, at once
+//   ArenaAlloc_release(&arena);
+//
+//   void *alloc(Self, size_t n)                              NULL on failure
+//   void *realloc(Self, void *p, size_t old_n, size_t new_n)  p may be NULL
+//   void  free(Self, void *p, size_t n)                       n as allocated
+//   void  reset(Self)                 free everything this allocator handed out
+//
+// The allocator is picked by type, so the choice is made per subsystem at
+// compile time and calls resolve to direct, inlinable calls: no function
+// pointer allocator struct.  Generated containers take the allocator type as
+// a parameter (see HashMapAlloc in traits/hash.h).
+//
+//   SystemAlloc  malloc/realloc/free; stateless, a NULL SystemAlloc * works.
+//                reset does nothing.
+//   ArenaAlloc   bump allocation in chunks of at least TRAIT_ARENA_CHUNK bytes,
+//                doubling; optionally starts in a caller buffer
+//                (ArenaAlloc_on(buf, n)).  free only reclaims the latest
+//                allocation, realloc extends it in place.  reset keeps the
+//                largest chunk.
+//   PoolAlloc    blocks of one size (PoolAlloc_new(size)) from slabs, with an
+//                intrusive free list; alloc/free are O(1), larger requests fail.
+//
+// Every allocation is aligned to TRAIT_ALLOC_ALIGN (16).  Allocator is
+// declared with AllocatorStatic, like traits/ord.h.
+// =============================================================================
+#ifndef TRAIT_ALLOC_H
+#define TRAIT_ALLOC_H
+
+#include "../trait.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define AllocatorSignature(Self)                 \
+  required(Self, void *, alloc, size_t)         \
+  required(Self, void *, realloc, void *, size_t, size_t) \
+  required(Self, void, free, void *, size_t)    \
+  required(Self, void, reset)
+#define AllocatorStatic 1
+#define Trait Allocator
+#include "../trait.h"
+
+#define TRAIT_ALLOC_ALIGN 16
+#define ___TRAIT_ALLOC_ROUND(n) (((n) + (TRAIT_ALLOC_ALIGN - 1)) & ~(size_t)(TRAIT_ALLOC_ALIGN - 1))
+// 1 if n can be rounded without wrapping to 0.
+#define ___TRAIT_ALLOC_FITS(n) ((n) <= SIZE_MAX - (TRAIT_ALLOC_ALIGN - 1))
+
+// Refill paths stay out of line so alloc's fast path inlines small.
+#if defined(__GNUC__) || defined(__clang__)
+#define ___TRAIT_ALLOC_SLOW __attribute__((__noinline__, __cold__))
+#else
+#define ___TRAIT_ALLOC_SLOW
+#endif
+
+#ifndef TRAIT_ARENA_CHUNK
+#define TRAIT_ARENA_CHUNK 65536
+#endif
+
+// ── SystemAlloc ──────────────────────────────────────────────────────────────
+typedef struct {
+  char unused;
+} SystemAlloc;
+
+#define For SystemAlloc
+#define Impl Allocator
+  static inline void *def(alloc, size_t n) { (void)self; return malloc(n); }
+  static inline void *def(realloc, void *p, size_t old_n, size_t n) { (void)self; (void)old_n; return realloc(p, n); }
+  static inline void def(free, void *p, size_t n) { (void)self; (void)n; free(p); }
+  static inline void def(reset) { (void)self; }
+#include "../trait.h"
+
+// ── ArenaAlloc ───────────────────────────────────────────────────────────────
+// Chunks are linked newest first; the newest is the largest.
+struct trait_arena_chunk {
+  struct trait_arena_chunk *prev;
+  size_t size; // usable bytes after the header
+};
+#define ___TRAIT_ARENA_HDR ___TRAIT_ALLOC_ROUND(sizeof(struct trait_arena_chunk))
+
+typedef struct {
+  char *cur, *end;
+  char *last; // start of the latest allocation (for free / realloc in place)
+  char *base; // start of the current region: the caller buffer or newest chunk
+  struct trait_arena_chunk *chunks;
+} ArenaAlloc;
+
+// An arena that hands out buf[0..n) before it mallocs.  buf must be aligned
+// to TRAIT_ALLOC_ALIGN and outlive the arena.
+___TRAIT_UNUSED static inline ArenaAlloc ArenaAlloc_on(void *buf, size_t n) {
+  ArenaAlloc a = { (char *)buf, (char *)buf + n, NULL, (char *)buf, NULL };
+  return a;
+}
+
+// Slow path: start a chunk that fits n.
+___TRAIT_UNUSED ___TRAIT_ALLOC_SLOW static void *___trait_arena_grow(ArenaAlloc *a, size_t n) {
+  size_t size = a->chunks ? a->chunks->size * 2 : TRAIT_ARENA_CHUNK;
+  if (a->chunks && a->chunks->size > SIZE_MAX / 2)
+    size = n;
+  while (size < n)
+    size = size > SIZE_MAX / 2 ? n : size * 2;
+  if (size > SIZE_MAX - ___TRAIT_ARENA_HDR)
+    return NULL;
+  struct trait_arena_chunk *c = (struct trait_arena_chunk *)malloc(___TRAIT_ARENA_HDR + size);
+  if (!c)
+    return NULL;
+  c->prev = a->chunks;
+  c->size = size;
+  a->chunks = c;
+  a->base = a->last = (char *)c + ___TRAIT_ARENA_HDR;
+  a->cur = a->last + n;
+  a->end = a->last + size;
+  return a->last;
+}
+
+// Frees every chunk.  The arena is empty (and reusable) afterwards.
+___TRAIT_UNUSED static inline void ArenaAlloc_release(ArenaAlloc *a) {
+  for (struct trait_arena_chunk *c = a->chunks, *prev; c; c = prev) {
+    prev = c->prev;
+    free(c);
+  }
+  memset(a, 0, sizeof *a);
+}
+
+#define For ArenaAlloc
+#define Impl Allocator
+  static inline void *def(alloc, size_t n) {
+    if (!___TRAIT_ALLOC_FITS(n))
+      return NULL;
+    n = ___TRAIT_ALLOC_ROUND(n);
+    if ((size_t)(self->end - self->cur) < n)
+      return ___trait_arena_grow(self, n);
+    self->last = self->cur;
+    self->cur += n;
+    return self->last;
+  }
+  static inline void *def(realloc, void *p, size_t old_n, size_t n) {
+    if (!___TRAIT_ALLOC_FITS(n))
+      return NULL;
+    if (p && p == self->last && (size_t)(self->end - self->last) >= ___TRAIT_ALLOC_ROUND(n)) {
+      self->cur = self->last + ___TRAIT_ALLOC_ROUND(n);
+      return p;
+    }
+    if (p && n <= old_n)
+      return p;
+    void *q = ArenaAlloc_Allocator_alloc(self, n);
+    if (q && p)
+      memcpy(q, p, old_n);
+    return q;
+  }
+  static inline void def(free, void *p, size_t n) {
+    (void)n;
+    if (p && p == self->last)
+      self->cur = self->last;
+  }
+  static inline void def(reset) {
+    if (self->chunks) {
+      for (struct trait_arena_chunk *c = self->chunks->prev, *prev; c; c = prev) {
+        prev = c->prev;
+        free(c);
+      }
+      self->chunks->prev = NULL;
+    }
+    self->cur = self->base;
+    self->last = NULL;
+  }
+#include "../trait.h"
+
+// ── PoolAlloc ────────────────────────────────────────────────────────────────
+struct trait_pool_slab {
+  struct trait_pool_slab *prev;
+  size_t blocks;
+};
+
+typedef struct {
+  size_t block;        // bytes per block, rounded to TRAIT_ALLOC_ALIGN
+  void *free_list;     // freed blocks, linked through their first word
+  char *cur, *end;     // unused tail of the newest slab
+  struct trait_pool_slab *slabs;
+} PoolAlloc;
+
+___TRAIT_UNUSED static inline PoolAlloc PoolAlloc_new(size_t block) {
+  // A block too large to round gets a size no slab can hold: alloc fails.
+  size_t size = !block ? TRAIT_ALLOC_ALIGN
+                : ___TRAIT_ALLOC_FITS(block) ? ___TRAIT_ALLOC_ROUND(block)
+                                             : SIZE_MAX & ~(size_t)(TRAIT_ALLOC_ALIGN - 1);
+  PoolAlloc p = { size, NULL, NULL, NULL, NULL };
+  return p;
+}
+
+___TRAIT_UNUSED ___TRAIT_ALLOC_SLOW static void *___trait_pool_grow(PoolAlloc *p) {
+  size_t blocks = p->slabs ? p->slabs->blocks * 2 : 64;
+  if (blocks > (SIZE_MAX - ___TRAIT_ARENA_HDR) / p->block)
+    return NULL;
+  struct trait_pool_slab *s =
+      (struct trait_pool_slab *)malloc(___TRAIT_ARENA_HDR + blocks * p->block);
+  if (!s)
+    return NULL;
+  s->prev = p->slabs;
+  s->blocks = blocks;
+  p->slabs = s;
+  p->cur = (char *)s + ___TRAIT_ARENA_HDR + p->block;
+  p->end = (char *)s + ___TRAIT_ARENA_HDR + blocks * p->block;
+  return (char *)s + ___TRAIT_ARENA_HDR;
+}
+
+___TRAIT_UNUSED static inline void PoolAlloc_release(PoolAlloc *p) {
+  for (struct trait_pool_slab *s = p->slabs, *prev; s; s = prev) {
+    prev = s->prev;
+    free(s);
+  }
+  *p = PoolAlloc_new(p->block);
+}
+
+#define For PoolAlloc
+#define Impl Allocator
+  static inline void *def(alloc, size_t n) {
+    if (n > self->block)
+      return NULL;
+    void *b = self->free_list;
+    if (b) {
+      memcpy(&self->free_list, b, sizeof(void *));
+      return b;
+    }
+    if (self->cur == self->end)
+      return ___trait_pool_grow(self);
+    b = self->cur;
+    self->cur += self->block;
+    return b;
+  }
+  static inline void *def(realloc, void *p, size_t old_n, size_t n) {
+    (void)old_n;
+    if (!p)
+      return PoolAlloc_Allocator_alloc(self, n);
+    return n <= self->block ? p : NULL;
+  }
+  static inline void def(free, void *p, size_t n) {
+    (void)n;
+    if (!p)
+      return;
+    memcpy(p, &self->free_list, sizeof(void *));
+    self->free_list = p;
+  }
+  static inline void def(reset) {
+    struct trait_pool_slab *keep = self->slabs;
+    self->free_list = NULL;
+    if (!keep)
+      return;
+    for (struct trait_pool_slab *s = keep->prev, *prev; s; s = prev) {
+      prev = s->prev;
+      free(s);
+    }
+    keep->prev = NULL;
+    self->cur = (char *)keep + ___TRAIT_ARENA_HDR;
+    self->end = self->cur + keep->blocks * self->block;
+  }
+#include "../trait.h"
+
+#endif // TRAIT_ALLOC_H
@@ -0,0 +1,90 @@
+// clang-format off
+// =============================================================================
+// traits/buf.h — growable byte buffers over an Allocator
+//
+//   #define BufName   FmtBuf         // the buffer type to define
+//   #define BufByte   char           // element type (default unsigned char)
+//   #define BufAlloc  ArenaAlloc     // storage (default SystemAlloc)
+//   #include "traits/buf.h"
+//
+// defines
+//
+//   typedef struct { BufByte *data; size_t len, cap; BufAlloc *alloc; int failed; } BufName;
+//
+//   int  BufName_reserve(BufName *b, size_t n)   room for n more bytes
+//   void BufName_put(BufName *b, const void *src, size_t n)
+//   void BufName_clear(BufName *b)               len = 0, storage kept
+//   void BufName_free(BufName *b)                storage back to b->alloc
+//
+// {0} is an empty buffer; with a stateful allocator set .alloc before the
+// first write.  Storage grows through call(Allocator.realloc, ...), doubling,
+// out of line, so writes inline to a bounds check and a copy.  If an
+// allocation fails, b->failed is set and the writes after it are dropped:
+// data then holds a prefix of the output.  traits/codec.h (EncodeBuf) and
+// traits/fmt.h (FmtBuf) are built on it.
+// =============================================================================
+#include "alloc.h"
+#include <stddef.h>
+#include <string.h>
+
+#ifndef BufName
+#error "traits/buf.h: #define BufName before including"
+#endif
+#ifndef BufByte
+#define BufByte unsigned char
+#endif
+#ifndef BufAlloc
+#define BufAlloc SystemAlloc
+#endif
+
+typedef struct {
+  BufByte *data;
+  size_t len, cap;
+  BufAlloc *alloc;  // NULL is fine for SystemAlloc
+  int failed;       // an allocation failed: data holds a prefix of the output
+} BufName;
+
+___TRAIT_UNUSED ___TRAIT_ALLOC_SLOW static int glue(BufName, _grow)(BufName *b, size_t n) {
+  if (b->failed)
+    return 0;
+  size_t cap = b->cap ? b->cap * 2 : 64;
+  while (cap - b->len < n)
+    cap *= 2;
+  BufByte *d = (BufByte *)call(Allocator.realloc, b->alloc, b->data, b->cap, cap);
+  if (!d) {
+    b->failed = 1;
+    return 0;
+  }
+  b->data = d;
+  b->cap = cap;
+  return 1;
+}
+
+// 1 if n more bytes fit (growing if needed), 0 after an allocation failure.
+___TRAIT_UNUSED static inline int glue(BufName, _reserve)(BufName *b, size_t n) {
+  return (b->cap - b->len >= n && !b->failed) || glue(BufName, _grow)(b, n);
+}
+
+___TRAIT_UNUSED static inline void glue(BufName, _put)(BufName *b, const void *src, size_t n) {
+  if (glue(BufName, _reserve)(b, n)) {
+    memcpy(b->data + b->len, src, n);
+    b->len += n;
+  }
+}
+
+___TRAIT_UNUSED static inline void glue(BufName, _clear)(BufName *b) {
+  if (!b->failed)
+    b->len = 0;
+}
+
+___TRAIT_UNUSED static inline void glue(BufName, _free)(BufName *b) {
+  BufAlloc *a = b->alloc;
+  if (b->data)
+    call(Allocator.free, a, b->data, b->cap);
+  memset(b, 0, sizeof *b);
+  b->alloc = a;
+}
+
+#undef BufName
+#undef BufByte
+#undef BufAlloc
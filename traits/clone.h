@@ -0,0 +1,122 @@
+// clang-format off
+// =============================================================================
+// traits/clone.h — Clone (deep copy) and Copy (bitwise copy) with batched
+//                  slice cloning
+//
+//   #include "traits/clone.h"
+//
+//   void clone(const Self *, void *dst)    construct a copy of *self in dst
+//   Copy                                   marker: the bytes are the value
+//
+//   #define CopyType Point                 // Copy + a memcpy Clone for Point
+//   #include "traits/clone.h"
+//
+//   #define For Doc                        // a type that owns memory
+//   #define Impl Clone
+//     void constdef(clone, void *dst) { ... deep copy into (Doc *)dst ... }
+//   #include "trait.h"
+//
+//   clone_slice(Point, dst, src, n);       // memcpy
+//   clone_slice(Doc, dst, src, n);         // loop of direct Doc_Clone_clone
+//   clone_slice(DynClone, dst, objs, n);   // one call per run of one type
+//
+// clone_slice(T, ...) calls clone_slice_T, stamped for every Clone impl (see
+// <Trait>Generics in trait.h); implements(T, Copy) picks memcpy at compile
+// time.  Like Rust, a Copy type also implements Clone: CopyType emits both.
+//
+// Clone is a dynamic trait, declared with CloneDynamic: including this header
+// does not change the static/dynamic flag of the including file (see
+// <Trait>Static in trait.h).  clone_slice_DynClone(void *const *dst,
+// const DynClone *src, n) clones src[i] into dst[i] (storage of the right
+// type) and calls the vtable once per run of equal vtables: clone_run, whose
+// per-type copy loops over that type's clone with direct calls.
+// int, long and double are Copy.
+// =============================================================================
+#ifndef TRAIT_CLONE_H
+#define TRAIT_CLONE_H
+
+#include "../trait.h"
+#include <stddef.h>
+#include <string.h>
+
+#define CopySignature(Self)
+#define CopyStatic 1
+#define Trait Copy
+#include "../trait.h"
+
+// clone_run(self, dst, src, n): clone src[0..n) (each a Self, src[0] == self)
+// into dst[0..n).
+#define CloneSignature(Self)                     \
+  required(immutable(Self), void, clone, void *) \
+  defaults(immutable(Self), void, clone_run, void *const *, const void *const *, size_t)
+#define CloneDynamic 1
+#define Trait Clone
+#include "../trait.h"
+
+// The default clone_run is instantiated per type with that type's vtable, so
+// the calls below resolve to direct calls of its clone.
+#define For Default
+#define Impl Clone
+  static inline void constdef(clone_run, void *const *dst, const void *const *src, size_t n) {
+    for (size_t i = 0; i < n; i++)
+      self->vt->clone(src[i], dst[i]);
+  }
+#include "../trait.h"
+
+#define CloneGenerics(X) X(clone_slice)
+#define clone_sliceGeneric(T)                                                  \
+  ___TRAIT_UNUSED static inline void glue(clone_slice_, T)(T *dst,             \
+      const T *src, size_t n) {                                                \
+    if (implements(T, Copy)) {                                                 \
+      if (n)                                                                   \
+        memcpy(dst, src, n * sizeof *src);                                     \
+    } else {                                                                   \
+      for (size_t i = 0; i < n; i++)                                           \
+        call(Clone.clone, &src[i], &dst[i]);                                   \
+    }                                                                          \
+  }
+
+#define clone_slice(T, dst, src, n) glue(clone_slice_, T)(dst, src, n)
+
+// Objects gathered per clone_run call.
+#ifndef TRAIT_CLONE_RUN
+#define TRAIT_CLONE_RUN 64
+#endif
+
+___TRAIT_UNUSED static inline void clone_slice_DynClone(void *const *dst, const DynClone *src, size_t n) {
+  const void *run[TRAIT_CLONE_RUN];
+  for (size_t i = 0; i < n;) {
+    const Clone_vtable *vt = src[i].vt;
+    size_t m = 0;
+    while (m < TRAIT_CLONE_RUN && i + m < n && src[i + m].vt == vt) {
+      run[m] = src[i + m].self;
+      m++;
+    }
+    vt->clone_run(run[0], dst + i, run, m);
+    i += m;
+  }
+}
+
+#define CopyType int
+#include "clone.h"
+#define CopyType long
+#include "clone.h"
+#define CopyType double
+#include "clone.h"
+
+#endif // TRAIT_CLONE_H
+
+// ── Reinclude: CopyType — Copy, and a Clone that copies the bytes ───────────
+#ifdef CopyType
+
+#define For CopyType
+#define Impl Copy
+#include "../trait.h"
+
+#define For CopyType
+#define Impl Clone
+  static inline void constdef(clone, void *dst) { memcpy(dst, self, sizeof *self); }
+#include "../trait.h"
+
+#undef CopyType
+#endif // CopyType
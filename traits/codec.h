@@ -0,0 +1,336 @@
+// clang-format off
+// =============================================================================
+// traits/codec.h — static Encode and Decode traits: a compact binary wire
+//                  format with field encoders resolved at compile time
+//
+//   #include "traits/codec.h"
+//
+//   typedef struct { unsigned id; double px; trait_str sym; } Quote;
+//   #define CodecStruct Quote                    // Encode + Decode, per field
+//   #define CodecFields(F) F(id) F(px) F(sym)
+//   #include "traits/codec.h"
+//
+//   EncodeBuf out = {0};
+//   encode_msg(&q, &out);             // one reservation, then the fields
+//   DecodeBuf in = DecodeBuf_on(out.data, out.len);
+//   if (!call(Decode.decode, &r, &in)) ...       // short or malformed input
+//   EncodeBuf_free(&out);
+//
+//   void   encode(const Self *, EncodeBuf *)  append the encoding
+//   size_t size_hint(const Self *)            at least the bytes encode appends
+//   int    decode(Self *, DecodeBuf *)        1, or 0 on short/malformed input
+//
+// Wire format: int and long are zigzag varints, unsigned and trait_ulong
+// (unsigned long) LEB128 varints, trait_uchar (unsigned char) one byte, float
+// and double IEEE little-endian, trait_str (const char *) a varint length, the
+// bytes and a NUL.  Varints must be in their shortest form and fit in 64
+// bits; decode rejects anything else.  A decoded trait_str points into the
+// input, which must outlive it.
+//
+// CodecStruct emits call(Encode.encode, &self->field, b) for each field in
+// CodecFields order.  Each call resolves to the field type's impl at compile
+// time: a direct, inlinable call, with no field table or function pointer.
+// A field may be a struct with its own impls, emitted before.
+//
+// Writes check capacity and grow out of line, so size_hint only sizes the one
+// reservation encode_msg makes.  If an allocation fails, out.failed is set and
+// later writes are dropped.  Encode and Decode are declared with
+// <Trait>Static, like traits/ord.h.
+// =============================================================================
+#ifndef TRAIT_CODEC_H
+#define TRAIT_CODEC_H
+
+#include "../trait.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// EncodeBuf: data, len, cap, alloc, failed; see traits/buf.h.
+#define BufName EncodeBuf
+#define BufByte uint8_t
+#include "buf.h"
+
+typedef struct {
+  const uint8_t *p, *end;
+} DecodeBuf;
+
+___TRAIT_UNUSED static inline DecodeBuf DecodeBuf_on(const void *data, size_t n) {
+  DecodeBuf in = { (const uint8_t *)data, (const uint8_t *)data + n };
+  return in;
+}
+
+#define EncodeSignature(Self)                    \
+  required(immutable(Self), void, encode, EncodeBuf *) \
+  required(immutable(Self), size_t, size_hint)
+#define EncodeStatic 1
+#define Trait Encode
+#include "../trait.h"
+
+#define DecodeSignature(Self)                    \
+  required(Self, int, decode, DecodeBuf *)
+#define DecodeStatic 1
+#define Trait Decode
+#include "../trait.h"
+
+#ifndef TRAIT_STR_DEFINED
+#define TRAIT_STR_DEFINED
+typedef const char *trait_str;
+#endif
+
+// Encodes *v after reserving its size_hint.  v and b are evaluated once
+// (twice without GNU statement expressions).
+#if defined(__GNUC__) || defined(__clang__)
+#define encode_msg(v, b)                                                       \
+  __extension__({                                                              \
+    ___TRAIT_TYPEOF(v) ___trait_v = (v);                                       \
+    EncodeBuf *___trait_b = (b);                                               \
+    EncodeBuf_reserve(___trait_b, call(Encode.size_hint, ___trait_v));         \
+    call(Encode.encode, ___trait_v, ___trait_b);                               \
+  })
+#else
+#define encode_msg(v, b)                                                       \
+  (EncodeBuf_reserve((b), call(Encode.size_hint, (v))),                        \
+   call(Encode.encode, (v), (b)))
+#endif
+
+// ── Varints and little-endian words ──────────────────────────────────────────
+___TRAIT_UNUSED static inline void trait_encode_varint(EncodeBuf *b, uint64_t v) {
+  if (!EncodeBuf_reserve(b, 10))
+    return;
+  uint8_t *p = b->data + b->len;
+  while (v >= 0x80) {
+    *p++ = (uint8_t)(v | 0x80);
+    v >>= 7;
+  }
+  *p++ = (uint8_t)v;
+  b->len = (size_t)(p - b->data);
+}
+
+// 0 if the input ends first, or the varint is longer than 10 bytes, does not
+// fit in 64 bits (a 10th byte above 1) or is not in its shortest form (a
+// final 0 byte after a continuation byte).
+___TRAIT_UNUSED static inline int trait_decode_varint(DecodeBuf *in, uint64_t *v) {
+  uint64_t x = 0;
+  for (unsigned s = 0; s < 70 && in->p < in->end; s += 7) {
+    uint8_t c = *in->p++;
+    if (s == 63 && c > 1)
+      return 0;
+    x |= (uint64_t)(c & 0x7f) << s;
+    if (c < 0x80) {
+      if (c == 0 && s)
+        return 0;
+      *v = x;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+// Zigzag: small magnitudes of either sign get short varints.
+#define ___TRAIT_ZIGZAG(v) (((uint64_t)(v) << 1) ^ (0 - ((uint64_t)(v) >> 63)))
+#define ___TRAIT_UNZIGZAG(u) ((int64_t)(((u) >> 1) ^ (0 - ((u) & 1))))
+
+// Byte by byte, so the format does not depend on the host; compilers turn
+// these into single loads and stores on little-endian targets.
+___TRAIT_UNUSED static inline void trait_encode_le(EncodeBuf *b, uint64_t v, unsigned n) {
+  uint8_t t[8];
+  for (unsigned i = 0; i < n; i++)
+    t[i] = (uint8_t)(v >> (8 * i));
+  EncodeBuf_put(b, t, n);
+}
+
+___TRAIT_UNUSED static inline int trait_decode_le(DecodeBuf *in, uint64_t *v, unsigned n) {
+  if ((size_t)(in->end - in->p) < n)
+    return 0;
+  uint64_t x = 0;
+  for (unsigned i = 0; i < n; i++)
+    x |= (uint64_t)in->p[i] << (8 * i);
+  in->p += n;
+  *v = x;
+  return 1;
+}
+
+// ── Builtin impls ────────────────────────────────────────────────────────────
+#define For int
+#define Impl Encode
+  static inline void constdef(encode, EncodeBuf *b) { trait_encode_varint(b, ___TRAIT_ZIGZAG((int64_t)*self)); }
+  static inline size_t constdef(size_hint) { (void)self; return 5; }
+#include "../trait.h"
+
+#define For int
+#define Impl Decode
+  static inline int def(decode, DecodeBuf *in) {
+    uint64_t u;
+    if (!trait_decode_varint(in, &u) || u > UINT32_MAX)
+      return 0;
+    *self = (int)___TRAIT_UNZIGZAG(u);
+    return 1;
+  }
+#include "../trait.h"
+
+#define For long
+#define Impl Encode
+  static inline void constdef(encode, EncodeBuf *b) { trait_encode_varint(b, ___TRAIT_ZIGZAG((int64_t)*self)); }
+  static inline size_t constdef(size_hint) { (void)self; return 10; }
+#include "../trait.h"
+
+#define For long
+#define Impl Decode
+  static inline int def(decode, DecodeBuf *in) {
+    uint64_t u;
+    if (!trait_decode_varint(in, &u))
+      return 0;
+    *self = (long)___TRAIT_UNZIGZAG(u);
+    return 1;
+  }
+#include "../trait.h"
+
+#define For unsigned
+#define Impl Encode
+  static inline void constdef(encode, EncodeBuf *b) { trait_encode_varint(b, *self); }
+  static inline size_t constdef(size_hint) { (void)self; return 5; }
+#include "../trait.h"
+
+#define For unsigned
+#define Impl Decode
+  static inline int def(decode, DecodeBuf *in) {
+    uint64_t u;
+    if (!trait_decode_varint(in, &u) || u > UINT32_MAX)
+      return 0;
+    *self = (unsigned)u;
+    return 1;
+  }
+#include "../trait.h"
+
+typedef unsigned long trait_ulong;
+
+#define For trait_ulong
+#define Impl Encode
+  static inline void constdef(encode, EncodeBuf *b) { trait_encode_varint(b, *self); }
+  static inline size_t constdef(size_hint) { (void)self; return 10; }
+#include "../trait.h"
+
+#define For trait_ulong
+#define Impl Decode
+  static inline int def(decode, DecodeBuf *in) {
+    uint64_t u;
+    if (!trait_decode_varint(in, &u))
+      return 0;
+    *self = (unsigned long)u;
+    return 1;
+  }
+#include "../trait.h"
+
+typedef unsigned char trait_uchar;
+
+#define For trait_uchar
+#define Impl Encode
+  static inline void constdef(encode, EncodeBuf *b) { EncodeBuf_put(b, self, 1); }
+  static inline size_t constdef(size_hint) { (void)self; return 1; }
+#include "../trait.h"
+
+#define For trait_uchar
+#define Impl Decode
+  static inline int def(decode, DecodeBuf *in) {
+    if (in->p == in->end)
+      return 0;
+    *self = *in->p++;
+    return 1;
+  }
+#include "../trait.h"
+
+#define For float
+#define Impl Encode
+  static inline void constdef(encode, EncodeBuf *b) {
+    uint32_t w;
+    memcpy(&w, self, 4);
+    trait_encode_le(b, w, 4);
+  }
+  static inline size_t constdef(size_hint) { (void)self; return 4; }
+#include "../trait.h"
+
+#define For float
+#define Impl Decode
+  static inline int def(decode, DecodeBuf *in) {
+    uint64_t w;
+    if (!trait_decode_le(in, &w, 4))
+      return 0;
+    uint32_t w32 = (uint32_t)w;
+    memcpy(self, &w32, 4);
+    return 1;
+  }
+#include "../trait.h"
+
+#define For double
+#define Impl Encode
+  static inline void constdef(encode, EncodeBuf *b) {
+    uint64_t w;
+    memcpy(&w, self, 8);
+    trait_encode_le(b, w, 8);
+  }
+  static inline size_t constdef(size_hint) { (void)self; return 8; }
+#include "../trait.h"
+
+#define For double
+#define Impl Decode
+  static inline int def(decode, DecodeBuf *in) {
+    uint64_t w;
+    if (!trait_decode_le(in, &w, 8))
+      return 0;
+    memcpy(self, &w, 8);
+    return 1;
+  }
+#include "../trait.h"
+
+#define For trait_str
+#define Impl Encode
+  static inline void constdef(encode, EncodeBuf *b) {
+    size_t n = strlen(*self);
+    trait_encode_varint(b, n);
+    EncodeBuf_put(b, *self, n + 1);
+  }
+  static inline size_t constdef(size_hint) { return strlen(*self) + 11; }
+#include "../trait.h"
+
+// Zero-copy: *self points into the input, at a NUL-terminated run of len bytes.
+#define For trait_str
+#define Impl Decode
+  static inline int def(decode, DecodeBuf *in) {
+    uint64_t n;
+    if (!trait_decode_varint(in, &n) || (uint64_t)(in->end - in->p) <= n || in->p[n] != 0)
+      return 0;
+    *self = (const char *)in->p;
+    in->p += n + 1;
+    return 1;
+  }
+#include "../trait.h"
+
+// ── CodecStruct field expansions ─────────────────────────────────────────────
+#define ___TRAIT_CODEC_HINT(f) + call(Encode.size_hint, &self->f)
+#define ___TRAIT_CODEC_ENCODE(f) call(Encode.encode, &self->f, b);
+#define ___TRAIT_CODEC_DECODE(f)                                               \
+  if (!call(Decode.decode, &self->f, in))                                      \
+    return 0;
+
+#endif // TRAIT_CODEC_H
+
+// ── Reinclude: CodecStruct — Encode and Decode, field by field ───────────────
+#if defined(CodecStruct) && defined(CodecFields)
+
+#define For CodecStruct
+#define Impl Encode
+  static inline void constdef(encode, EncodeBuf *b) { CodecFields(___TRAIT_CODEC_ENCODE) }
+  static inline size_t constdef(size_hint) { return 0 CodecFields(___TRAIT_CODEC_HINT); }
+#include "../trait.h"
+
+#define For CodecStruct
+#define Impl Decode
+  static inline int def(decode, DecodeBuf *in) {
+    CodecFields(___TRAIT_CODEC_DECODE)
+    return 1;
+  }
+#include "../trait.h"
+
+#undef CodecStruct
+#undef CodecFields
+#endif // CodecStruct && CodecFields
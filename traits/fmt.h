@@ -0,0 +1,273 @@
+// clang-format off
+// =============================================================================
+// traits/fmt.h — static Format trait: text into an arena-backed buffer, no stdio
+//
+//   #include "traits/fmt.h"
+//
+//   #define For Point
+//   #define Impl Format
+//     void constdef(fmt, FmtBuf *b) {
+//       fmt_lit(b, "(");
+//       call(Format.fmt, &self->x, b);        // direct call to int's impl
+//       fmt_lit(b, ", ");
+//       call(Format.fmt, &self->y, b);
+//       fmt_lit(b, ")");
+//     }
+//   #include "trait.h"
+//
+//   ArenaAlloc arena = {0};
+//   FmtBuf b = FmtBuf_in(&arena);
+//   format_value(&p, &b);                     // reserve len_hint, then fmt
+//   fwrite(b.data, 1, b.len, stdout);         // one stdio call per batch
+//   FmtBuf_clear(&b);                         // reuse the storage
+//   ArenaAlloc_release(&arena);
+//
+//   void   fmt(const Self *, FmtBuf *)        append the text
+//   size_t len_hint(const Self *)             expected length (default 16)
+//
+// Format is static, so call(Format.fmt, &field, b) inside an impl resolves to
+// the field type's impl at compile time: formatting a nested struct is a tree
+// of direct, inlinable calls.  Nothing locks stdio or formats through a
+// format string; the caller decides when the text is written out.
+//
+// FmtBuf is a traits/buf.h buffer over an ArenaAlloc: it grows through
+// call(Allocator.realloc, arena, ...), which extends the latest arena
+// allocation in place, and its storage lives until the arena is reset or
+// released.  If an allocation fails, b.failed is set and later writes are
+// dropped.  b.data is not NUL-terminated; FmtBuf_str adds one.
+//
+// Writers: fmt_lit (string literal, length known at compile time), fmt_str,
+// fmt_char, fmt_u64 / fmt_i64 (two digits per step), fmt_f64 (the same text
+// as printf "%.*f" with prec <= 9; exact integer math below 2^53, snprintf
+// above).
+// Impls for int, long, unsigned, char, float, double (TRAIT_FMT_PREC digits)
+// and trait_str (const char *) are provided.  Format is declared with
+// FormatStatic, like traits/ord.h.
+// =============================================================================
+#ifndef TRAIT_FMT_H
+#define TRAIT_FMT_H
+
+#include "../trait.h"
+#include "alloc.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+// FmtBuf: data, len, cap, alloc, failed; see traits/buf.h.
+#define BufName FmtBuf
+#define BufByte char
+#define BufAlloc ArenaAlloc
+#include "buf.h"
+
+___TRAIT_UNUSED static inline FmtBuf FmtBuf_in(ArenaAlloc *arena) {
+  FmtBuf b = { NULL, 0, 0, arena, 0 };
+  return b;
+}
+
+#define FormatSignature(Self)                    \
+  required(immutable(Self), void, fmt, FmtBuf *) \
+  defaults(immutable(Self), size_t, len_hint)
+#define FormatStatic 1
+#define Trait Format
+#include "../trait.h"
+
+#define For Default
+#define Impl Format
+  static inline size_t constdef(len_hint) { (void)self; return 16; }
+#include "../trait.h"
+
+#ifndef TRAIT_STR_DEFINED
+#define TRAIT_STR_DEFINED
+typedef const char *trait_str;
+#endif
+
+#ifndef TRAIT_FMT_PREC
+#define TRAIT_FMT_PREC 6
+#endif
+
+// ── FmtBuf ───────────────────────────────────────────────────────────────────
+// The text as a C string ("" after an allocation failure).
+___TRAIT_UNUSED static inline const char *FmtBuf_str(FmtBuf *b) {
+  if (!FmtBuf_reserve(b, 1))
+    return "";
+  b->data[b->len] = '\0';
+  return b->data;
+}
+
+// Formats *v after reserving its len_hint.  v and b are evaluated once
+// (twice without GNU statement expressions).
+#if defined(__GNUC__) || defined(__clang__)
+#define format_value(v, b)                                                     \
+  __extension__({                                                              \
+    ___TRAIT_TYPEOF(v) ___trait_v = (v);                                       \
+    FmtBuf *___trait_b = (b);                                                  \
+    FmtBuf_reserve(___trait_b, call(Format.len_hint, ___trait_v));             \
+    call(Format.fmt, ___trait_v, ___trait_b);                                  \
+  })
+#else
+#define format_value(v, b)                                                     \
+  (FmtBuf_reserve((b), call(Format.len_hint, (v))),                            \
+   call(Format.fmt, (v), (b)))
+#endif
+
+// ── Writers ──────────────────────────────────────────────────────────────────
+#define fmt_lit(b, s) FmtBuf_put((b), "" s, sizeof(s) - 1)
+
+___TRAIT_UNUSED static inline void fmt_str(FmtBuf *b, const char *s) { FmtBuf_put(b, s, strlen(s)); }
+
+___TRAIT_UNUSED static inline void fmt_char(FmtBuf *b, char c) {
+  if (FmtBuf_reserve(b, 1))
+    b->data[b->len++] = c;
+}
+
+___TRAIT_UNUSED static const char ___trait_fmt_digits[201] =
+  "0001020304050607080910111213141516171819"
+  "2021222324252627282930313233343536373839"
+  "4041424344454647484950515253545556575859"
+  "6061626364656667686970717273747576777879"
+  "8081828384858687888990919293949596979899";
+
+// Writes v right-aligned ending at end, zero-padded to at least width digits;
+// returns the first digit.
+___TRAIT_UNUSED static inline char *___trait_fmt_digits_to(char *end, uint64_t v, unsigned width) {
+  char *p = end;
+  while (v >= 100) {
+    unsigned i = (unsigned)(v % 100) * 2;
+    v /= 100;
+    *--p = ___trait_fmt_digits[i + 1];
+    *--p = ___trait_fmt_digits[i];
+  }
+  if (v >= 10) {
+    *--p = ___trait_fmt_digits[v * 2 + 1];
+    *--p = ___trait_fmt_digits[v * 2];
+  } else {
+    *--p = (char)('0' + v);
+  }
+  while ((unsigned)(end - p) < width)
+    *--p = '0';
+  return p;
+}
+
+___TRAIT_UNUSED static inline void fmt_u64(FmtBuf *b, uint64_t v) {
+  char t[20], *p = ___trait_fmt_digits_to(t + sizeof t, v, 1);
+  FmtBuf_put(b, p, (size_t)(t + sizeof t - p));
+}
+
+___TRAIT_UNUSED static inline void fmt_i64(FmtBuf *b, int64_t v) {
+  char t[21], *p = ___trait_fmt_digits_to(t + sizeof t, v < 0 ? 0 - (uint64_t)v : (uint64_t)v, 1);
+  if (v < 0)
+    *--p = '-';
+  FmtBuf_put(b, p, (size_t)(t + sizeof t - p));
+}
+
+// printf("%.*f") straight into the buffer: at most 309 integer digits.
+___TRAIT_UNUSED ___TRAIT_ALLOC_SLOW static void ___trait_fmt_f64_slow(FmtBuf *b, double v, unsigned prec) {
+  if (!FmtBuf_reserve(b, 330))
+    return;
+  int n = snprintf(b->data + b->len, 330, "%.*f", (int)prec, v);
+  if (n > 0)
+    b->len += (size_t)n;
+}
+
+#ifdef __SIZEOF_INT128__
+__extension__ typedef unsigned __int128 ___trait_fmt_u128;
+#endif
+
+// printf("%.*f", prec, v) for prec 0..9 (larger is clamped to 9).  Below
+// 2^53 the value is m * 2^e exactly, so v * 10^prec is an exact 128-bit
+// product, rounded half to even like printf; anything else (and targets
+// without 128-bit integers) goes to snprintf.
+___TRAIT_UNUSED static inline void fmt_f64(FmtBuf *b, double v, unsigned prec) {
+  static const uint32_t scales[10] = { 1, 10, 100, 1000, 10000, 100000, 1000000,
+                                       10000000, 100000000, 1000000000 };
+  if (prec > 9)
+    prec = 9;
+#ifdef __SIZEOF_INT128__
+  uint64_t bits;
+  memcpy(&bits, &v, 8);
+  int neg = (int)(bits >> 63), e = (int)(bits >> 52 & 0x7ff);
+  uint64_t m = bits & 0xfffffffffffffull;
+  if (e >= 1075 - 52 + 53) { // 2^53 and up, inf, NaN
+    ___trait_fmt_f64_slow(b, v, prec);
+    return;
+  }
+  if (e)
+    m |= 1ull << 52;
+  else
+    e = 1; // subnormal
+  int sh = 1075 - e; // v = m / 2^sh, and sh >= 0 here
+  ___trait_fmt_u128 n = (___trait_fmt_u128)m * scales[prec], r;
+  if (sh == 0) {
+    r = n;
+  } else if (sh > 84) { // n < 2^84 <= half: rounds to 0
+    r = 0;
+  } else {
+    ___trait_fmt_u128 rem = n & ((((___trait_fmt_u128)1) << sh) - 1), half = ((___trait_fmt_u128)1) << (sh - 1);
+    r = n >> sh;
+    if (rem > half || (rem == half && (r & 1)))
+      r++;
+  }
+  char t[40], *end = t + sizeof t, *p = end;
+  if (prec) {
+    p = ___trait_fmt_digits_to(end, (uint64_t)(r % scales[prec]), prec);
+    *--p = '.';
+  }
+  p = ___trait_fmt_digits_to(p, (uint64_t)(r / scales[prec]), 1);
+  if (neg)
+    *--p = '-';
+  FmtBuf_put(b, p, (size_t)(end - p));
+#else
+  ___trait_fmt_f64_slow(b, v, prec);
+#endif
+}
+
+// ── Builtin impls ────────────────────────────────────────────────────────────
+#define For int
+#define Impl Format
+  static inline void constdef(fmt, FmtBuf *b) { fmt_i64(b, *self); }
+#define Override_int_Format_len_hint 1
+  static inline size_t constdef(len_hint) { (void)self; return 11; }
+#include "../trait.h"
+
+#define For long
+#define Impl Format
+  static inline void constdef(fmt, FmtBuf *b) { fmt_i64(b, *self); }
+#define Override_long_Format_len_hint 1
+  static inline size_t constdef(len_hint) { (void)self; return 20; }
+#include "../trait.h"
+
+#define For unsigned
+#define Impl Format
+  static inline void constdef(fmt, FmtBuf *b) { fmt_u64(b, *self); }
+#define Override_unsigned_Format_len_hint 1
+  static inline size_t constdef(len_hint) { (void)self; return 10; }
+#include "../trait.h"
+
+#define For char
+#define Impl Format
+  static inline void constdef(fmt, FmtBuf *b) { fmt_char(b, *self); }
+#define Override_char_Format_len_hint 1
+  static inline size_t constdef(len_hint) { (void)self; return 1; }
+#include "../trait.h"
+
+#define For float
+#define Impl Format
+  static inline void constdef(fmt, FmtBuf *b) { fmt_f64(b, *self, TRAIT_FMT_PREC); }
+#include "../trait.h"
+
+#define For double
+#define Impl Format
+  static inline void constdef(fmt, FmtBuf *b) { fmt_f64(b, *self, TRAIT_FMT_PREC); }
+#define Override_double_Format_len_hint 1
+  static inline size_t constdef(len_hint) { (void)self; return 24; }
+#include "../trait.h"
+
+#define For trait_str
+#define Impl Format
+  static inline void constdef(fmt, FmtBuf *b) { fmt_str(b, *self); }
+#define Override_trait_str_Format_len_hint 1
+  static inline size_t constdef(len_hint) { return strlen(*self); }
+#include "../trait.h"
+
+#endif // TRAIT_FMT_H
@@ -0,0 +1,332 @@
+// clang-format off
+// =============================================================================
+// traits/hash.h — static Hash and Eq traits and a Swiss-table HashMap(K, V)
+//
+//   #include "traits/hash.h"
+//
+//   #define For Point
+//   #define Impl Hash
+//     uint64_t constdef(hash) { return trait_hash_mix((uint64_t)self->x << 32 ^ (uint32_t)self->y); }
+//   #include "trait.h"
+//   #define For Point
+//   #define Impl Eq
+//     int constdef(eq, const Point *o) { return self->x == o->x && self->y == o->y; }
+//   #include "trait.h"
+//
+//   #define HashMapKey Point           // instantiate HashMap(Point, int)
+//   #define HashMapValue int
+//   #include "traits/hash.h"
+//
+//   HashMap(Point, int) m = {0};                    // zero-initialized = empty
+//   HashMap_Point_int_put(&m, p, 7);                // insert or overwrite
+//   int *v = HashMap_Point_int_get(&m, p);          // NULL if absent
+//   HashMap_Point_int_remove(&m, p);
+//   HashMap_Point_int_free(&m);
+//
+// Storage comes from HashMapAlloc (default SystemAlloc, see traits/alloc.h):
+//   #define HashMapAlloc ArenaAlloc     // then m.alloc = &arena before use
+//
+// Hashing and key comparison are call(Hash.hash, ...) and call(Eq.eq, ...),
+// resolved at compile time to K's impls, and keys and values are stored
+// inline: a probe makes no indirect call and follows no key pointer.
+//
+// Layout follows Swiss tables: one control byte per slot (EMPTY, DELETED, or
+// the low 7 bits of the hash) and probing 16 control bytes at a time, with
+// SSE2 where available (-DTRAIT_HASH_SCALAR forces the portable loop).  Only
+// slots whose control byte matches are compared with Eq.  Maximum load is 7/8.
+//
+// Hash, Eq are declared with <Trait>Static, like traits/ord.h.  Impls for int,
+// long and trait_str (const char *, compared by content) are provided.
+// =============================================================================
+#ifndef TRAIT_HASH_H
+#define TRAIT_HASH_H
+
+#include "../trait.h"
+#include "alloc.h"
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__SSE2__) && !defined(TRAIT_HASH_SCALAR)
+#include <emmintrin.h>
+#define TRAIT_HASH_SIMD 1
+#else
+#define TRAIT_HASH_SIMD 0
+#endif
+
+#define HashSignature(Self)                      \
+  required(immutable(Self), uint64_t, hash)
+#define HashStatic 1
+#define Trait Hash
+#include "../trait.h"
+
+#define EqSignature(Self)                        \
+  required(immutable(Self), int, eq, const For *)
+#define EqStatic 1
+#define Trait Eq
+#include "../trait.h"
+
+// 64-bit finalizer (murmur3 fmix64): every input bit affects every output bit,
+// so both the probe position (high bits) and the control byte (low 7) vary.
+___TRAIT_UNUSED static inline uint64_t trait_hash_mix(uint64_t x) {
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdull;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ull;
+  return x ^ (x >> 33);
+}
+
+___TRAIT_UNUSED static inline uint64_t trait_hash_bytes(const void *p, size_t n) {
+  const unsigned char *s = (const unsigned char *)p;
+  uint64_t h = 0x9e3779b97f4a7c15ull ^ n, w;
+  for (; n >= 8; n -= 8, s += 8) {
+    memcpy(&w, s, 8);
+    h = (h ^ w) * 0xff51afd7ed558ccdull;
+    h ^= h >> 32;
+  }
+  w = 0;
+  memcpy(&w, s, n);
+  return trait_hash_mix(h ^ w);
+}
+
+#ifndef TRAIT_STR_DEFINED
+#define TRAIT_STR_DEFINED
+typedef const char *trait_str;
+#endif
+
+#define For int
+#define Impl Hash
+  static inline uint64_t constdef(hash) { return trait_hash_mix((uint64_t)(unsigned)*self); }
+#include "../trait.h"
+
+#define For int
+#define Impl Eq
+  static inline int constdef(eq, const int *other) { return *self == *other; }
+#include "../trait.h"
+
+#define For long
+#define Impl Hash
+  static inline uint64_t constdef(hash) { return trait_hash_mix((uint64_t)*self); }
+#include "../trait.h"
+
+#define For long
+#define Impl Eq
+  static inline int constdef(eq, const long *other) { return *self == *other; }
+#include "../trait.h"
+
+#define For trait_str
+#define Impl Hash
+  static inline uint64_t constdef(hash) { return trait_hash_bytes(*self, strlen(*self)); }
+#include "../trait.h"
+
+#define For trait_str
+#define Impl Eq
+  static inline int constdef(eq, const trait_str *other) { return strcmp(*self, *other) == 0; }
+#include "../trait.h"
+
+#define HashMap(K, V) glue4(HashMap_, K, _, V)
+
+// ── Control-byte groups ──────────────────────────────────────────────────────
+// ctrl has cap + TRAIT_HASH_GROUP bytes; the tail mirrors the first group so
+// a group load at any slot index stays in bounds.
+#define TRAIT_HASH_GROUP 16
+#define ___TRAIT_HASH_EMPTY 0x80
+#define ___TRAIT_HASH_DELETED 0xfe
+
+// Bit i set if g[i] == c.
+___TRAIT_UNUSED static inline unsigned ___trait_hash_match(const unsigned char *g, unsigned char c) {
+#if TRAIT_HASH_SIMD
+  __m128i v = _mm_loadu_si128((const __m128i *)(const void *)g);
+  return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8((char)c)));
+#else
+  unsigned m = 0;
+  for (unsigned i = 0; i < TRAIT_HASH_GROUP; i++)
+    m |= (unsigned)(g[i] == c) << i;
+  return m;
+#endif
+}
+
+// Bit i set if g[i] is EMPTY or DELETED (the only bytes with the top bit set).
+___TRAIT_UNUSED static inline unsigned ___trait_hash_match_free(const unsigned char *g) {
+#if TRAIT_HASH_SIMD
+  return (unsigned)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)(const void *)g));
+#else
+  unsigned m = 0;
+  for (unsigned i = 0; i < TRAIT_HASH_GROUP; i++)
+    m |= (unsigned)(g[i] >> 7) << i;
+  return m;
+#endif
+}
+
+#endif // TRAIT_HASH_H
+
+// ── Reinclude: instantiate HashMap(HashMapKey, HashMapValue) ─────────────────
+#if defined(HashMapKey) && defined(HashMapValue)
+
+#ifndef HashMapAlloc
+#define HashMapAlloc SystemAlloc
+#endif
+#define ___TRAIT_HM HashMap(HashMapKey, HashMapValue)
+
+typedef struct {
+  HashMapKey key;
+  HashMapValue val;
+} glue(___TRAIT_HM, _entry);
+
+typedef struct {
+  unsigned char *ctrl;               // inside the slots allocation, after slots
+  glue(___TRAIT_HM, _entry) *slots;
+  size_t cap;       // 0 or a power of two >= TRAIT_HASH_GROUP
+  size_t len;
+  size_t growth;    // EMPTY slots that may still be filled before a rehash
+  HashMapAlloc *alloc;               // NULL is fine for SystemAlloc
+} ___TRAIT_HM;
+
+// Bytes of the single allocation holding cap slots and their control bytes.
+___TRAIT_UNUSED static inline size_t glue(___TRAIT_HM, _bytes)(size_t cap) {
+  return cap * sizeof(glue(___TRAIT_HM, _entry)) + cap + TRAIT_HASH_GROUP;
+}
+
+___TRAIT_UNUSED static inline void glue(___TRAIT_HM, _set_ctrl)(___TRAIT_HM *m, size_t i,
+                                                                unsigned char c) {
+  m->ctrl[i] = c;
+  m->ctrl[((i - TRAIT_HASH_GROUP) & (m->cap - 1)) + TRAIT_HASH_GROUP] = c;
+}
+
+// First EMPTY or DELETED slot on h's probe sequence.
+___TRAIT_UNUSED static inline size_t glue(___TRAIT_HM, _free_slot)(const ___TRAIT_HM *m, uint64_t h) {
+  size_t mask = m->cap - 1, pos = (size_t)(h >> 7) & mask, step = 0;
+  unsigned bits;
+  while (!(bits = ___trait_hash_match_free(m->ctrl + pos))) {
+    step += TRAIT_HASH_GROUP;
+    pos = (pos + step) & mask;
+  }
+  return (pos + (size_t)__builtin_ctz(bits)) & mask;
+}
+
+// Slot holding key, or cap.
+___TRAIT_UNUSED static inline size_t glue(___TRAIT_HM, _find)(const ___TRAIT_HM *m,
+                                                              const HashMapKey *key, uint64_t h) {
+  size_t mask = m->cap - 1, pos = (size_t)(h >> 7) & mask, step = 0;
+  unsigned char h2 = (unsigned char)(h & 0x7f);
+  if (!m->cap)
+    return m->cap;
+  for (;;) {
+    const unsigned char *g = m->ctrl + pos;
+    for (unsigned bits = ___trait_hash_match(g, h2); bits; bits &= bits - 1) {
+      size_t i = (pos + (size_t)__builtin_ctz(bits)) & mask;
+      if (call(Eq.eq, &m->slots[i].key, key))
+        return i;
+    }
+    if (___trait_hash_match(g, ___TRAIT_HASH_EMPTY))
+      return m->cap;
+    step += TRAIT_HASH_GROUP;
+    pos = (pos + step) & mask;
+  }
+}
+
+// Moves every entry into a fresh table of cap slots.  0 on allocation failure.
+___TRAIT_UNUSED static inline int glue(___TRAIT_HM, _rehash)(___TRAIT_HM *m, size_t cap) {
+  void *mem = call(Allocator.alloc, m->alloc, glue(___TRAIT_HM, _bytes)(cap));
+  if (!mem)
+    return 0;
+  ___TRAIT_HM n = { (unsigned char *)((glue(___TRAIT_HM, _entry) *)mem + cap),
+                    (glue(___TRAIT_HM, _entry) *)mem, cap, m->len, cap - cap / 8 - m->len,
+                    m->alloc };
+  memset(n.ctrl, ___TRAIT_HASH_EMPTY, cap + TRAIT_HASH_GROUP);
+  for (size_t i = 0; i < m->cap; i++)
+    if (!(m->ctrl[i] & 0x80)) {
+      uint64_t h = call(Hash.hash, &m->slots[i].key);
+      size_t j = glue(___TRAIT_HM, _free_slot)(&n, h);
+      glue(___TRAIT_HM, _set_ctrl)(&n, j, (unsigned char)(h & 0x7f));
+      n.slots[j] = m->slots[i];
+    }
+  if (m->cap)
+    call(Allocator.free, m->alloc, m->slots, glue(___TRAIT_HM, _bytes)(m->cap));
+  *m = n;
+  return 1;
+}
+
+// Grows so that n entries fit without a rehash.  0 on allocation failure.
+___TRAIT_UNUSED static inline int glue(___TRAIT_HM, _reserve)(___TRAIT_HM *m, size_t n) {
+  size_t cap = m->cap ? m->cap : TRAIT_HASH_GROUP;
+  while (cap - cap / 8 < n)
+    cap *= 2;
+  return cap == m->cap || glue(___TRAIT_HM, _rehash)(m, cap);
+}
+
+// Pointer to key's value, or NULL.
+___TRAIT_UNUSED static inline HashMapValue *glue(___TRAIT_HM, _get)(const ___TRAIT_HM *m,
+                                                                    HashMapKey key) {
+  size_t i = glue(___TRAIT_HM, _find)(m, &key, call(Hash.hash, &key));
+  return i < m->cap ? &m->slots[i].val : NULL;
+}
+
+// Inserts key or overwrites its value.  Returns the stored value, or NULL if
+// the table had to grow and allocation failed.
+___TRAIT_UNUSED static inline HashMapValue *glue(___TRAIT_HM, _put)(___TRAIT_HM *m, HashMapKey key,
+                                                                    HashMapValue val) {
+  uint64_t h = call(Hash.hash, &key);
+  size_t i = glue(___TRAIT_HM, _find)(m, &key, h);
+  if (i < m->cap) {
+    m->slots[i].val = val;
+    return &m->slots[i].val;
+  }
+  if (!m->growth) {
+    // Mostly tombstones: rebuild at the same size; otherwise double.
+    size_t cap = !m->cap ? TRAIT_HASH_GROUP : m->len < m->cap / 2 ? m->cap : m->cap * 2;
+    if (!glue(___TRAIT_HM, _rehash)(m, cap))
+      return NULL;
+  }
+  i = glue(___TRAIT_HM, _free_slot)(m, h);
+  m->growth -= m->ctrl[i] == ___TRAIT_HASH_EMPTY;
+  glue(___TRAIT_HM, _set_ctrl)(m, i, (unsigned char)(h & 0x7f));
+  m->slots[i].key = key;
+  m->slots[i].val = val;
+  m->len++;
+  return &m->slots[i].val;
+}
+
+// 1 if key was present.  Its slot becomes a tombstone until the next rehash.
+___TRAIT_UNUSED static inline int glue(___TRAIT_HM, _remove)(___TRAIT_HM *m, HashMapKey key) {
+  size_t i = glue(___TRAIT_HM, _find)(m, &key, call(Hash.hash, &key));
+  if (i >= m->cap)
+    return 0;
+  glue(___TRAIT_HM, _set_ctrl)(m, i, ___TRAIT_HASH_DELETED);
+  m->len--;
+  return 1;
+}
+
+// Iterates the entries in slot order:
+//   size_t it = 0;
+//   for (HashMap_K_V_entry *e; (e = HashMap_K_V_next(&m, &it));) ...
+___TRAIT_UNUSED static inline glue(___TRAIT_HM, _entry) *glue(___TRAIT_HM, _next)(const ___TRAIT_HM *m,
+                                                                                  size_t *it) {
+  for (; *it < m->cap; ++*it)
+    if (!(m->ctrl[*it] & 0x80))
+      return &m->slots[(*it)++];
+  return NULL;
+}
+
+// Removes every entry and keeps the capacity.
+___TRAIT_UNUSED static inline void glue(___TRAIT_HM, _clear)(___TRAIT_HM *m) {
+  if (m->cap)
+    memset(m->ctrl, ___TRAIT_HASH_EMPTY, m->cap + TRAIT_HASH_GROUP);
+  m->len = 0;
+  m->growth = m->cap - m->cap / 8;
+}
+
+// Returns the table to the allocator.  The map is empty (and reusable, with
+// the same allocator) afterwards.
+___TRAIT_UNUSED static inline void glue(___TRAIT_HM, _free)(___TRAIT_HM *m) {
+  HashMapAlloc *a = m->alloc;
+  if (m->cap)
+    call(Allocator.free, a, m->slots, glue(___TRAIT_HM, _bytes)(m->cap));
+  memset(m, 0, sizeof *m);
+  m->alloc = a;
+}
+
+#undef ___TRAIT_HM
+#undef HashMapKey
+#undef HashMapValue
+#undef HashMapAlloc
+#endif // HashMapKey && HashMapValue
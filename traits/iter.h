@@ -0,0 +1,257 @@
+// clang-format off
+// =============================================================================
+// traits/iter.h — static Iterator trait and adapters fused at compile time
+//
+//   #include "traits/iter.h"
+//
+// An iterator type T has an associated item type, the typedef T_Item, and
+// implements   int next(T *self, T_Item *out)   (0 once exhausted):
+//
+//   typedef struct { FILE *f; } Lines;
+//   typedef Record Lines_Item;
+//   #define For Lines
+//   #define Impl Iterator
+//     int def(next, Lines_Item *out) { return read_record(self->f, out); }
+//   #include "trait.h"
+//
+// Each reinclude below defines one concrete type (and its _Item typedef) and
+// its Iterator impl.  Adapters hold the iterator they wrap by value, so a
+// pipeline is one nested struct with no pointers, and every next() down the
+// chain is a call(Iterator.next, ...) resolved at compile time: after
+// inlining, draining a pipeline is a single loop.
+//
+//   #define IterSlice Recs                    // Recs: elements of a const Rec *
+//   #define IterItem Rec
+//   #define IterFilter Slow                   // Slow: items of From passing Fn
+//   #define IterFrom Recs                     //   int Fn(const From_Item *)
+//   #define IterFn is_slow
+//   #define IterMap Millis                    // Millis: To Fn(const From_Item *)
+//   #define IterFrom Slow
+//   #define IterFn millis
+//   #define IterTo double
+//   #define IterTake First                    // First: at most n items of From
+//   #define IterFrom Millis
+//   #define IterZip Pairs                     // Pairs: {From_Item a; With_Item b}
+//   #define IterFrom A
+//   #define IterWith B
+//   #define IterChain Both                    // Both: From, then With (same Item)
+//   #define IterFrom A
+//   #define IterWith B
+//   (each followed by #include "traits/iter.h")
+//
+//   First it = First_new(Millis_new(Slow_new(Recs_new(recs, n))), 10);
+//   for (double ms; call(Iterator.next, &it, &ms);) ...
+//
+// Range (Item long, [begin, end)) is predefined.  Iterator is declared with
+// IteratorStatic, like traits/ord.h.
+// =============================================================================
+#ifndef TRAIT_ITER_H
+#define TRAIT_ITER_H
+
+#include "../trait.h"
+#include <stddef.h>
+
+// Associated type: the item type of the implementing type.
+#define Iterator_Item glue(For, _Item)
+
+#define IteratorSignature(Self)                  \
+  required(Self, int, next, Iterator_Item *)
+#define IteratorStatic 1
+#define Trait Iterator
+#include "../trait.h"
+
+typedef struct {
+  long cur, end;
+} Range;
+typedef long Range_Item;
+
+___TRAIT_UNUSED static inline Range Range_new(long begin, long end) {
+  Range r = { begin, end };
+  return r;
+}
+
+#define For Range
+#define Impl Iterator
+  static inline int def(next, long *out) {
+    if (self->cur >= self->end)
+      return 0;
+    *out = self->cur++;
+    return 1;
+  }
+#include "../trait.h"
+
+#endif // TRAIT_ITER_H
+
+// ── Reinclude: IterSlice — the elements of a const IterItem array ──────────
+#ifdef IterSlice
+
+typedef struct {
+  const IterItem *cur, *end;
+} IterSlice;
+typedef IterItem glue(IterSlice, _Item);
+
+___TRAIT_UNUSED static inline IterSlice glue(IterSlice, _new)(const IterItem *a, size_t n) {
+  IterSlice it = { a, a + n };
+  return it;
+}
+
+#define For IterSlice
+#define Impl Iterator
+  static inline int def(next, IterItem *out) {
+    if (self->cur == self->end)
+      return 0;
+    *out = *self->cur++;
+    return 1;
+  }
+#include "../trait.h"
+
+#undef IterSlice
+#undef IterItem
+#endif // IterSlice
+
+// ── Reinclude: IterMap — To Fn(const From_Item *) over each item ─────────────
+#ifdef IterMap
+
+typedef struct {
+  IterFrom inner;
+} IterMap;
+typedef IterTo glue(IterMap, _Item);
+
+___TRAIT_UNUSED static inline IterMap glue(IterMap, _new)(IterFrom inner) {
+  IterMap it = { inner };
+  return it;
+}
+
+#define For IterMap
+#define Impl Iterator
+  static inline int def(next, IterTo *out) {
+    glue(IterFrom, _Item) x;
+    if (!call(Iterator.next, &self->inner, &x))
+      return 0;
+    *out = IterFn(&x);
+    return 1;
+  }
+#include "../trait.h"
+
+#undef IterMap
+#undef IterFrom
+#undef IterFn
+#undef IterTo
+#endif // IterMap
+
+// ── Reinclude: IterFilter — items for which int Fn(const Item *) holds ───────
+#ifdef IterFilter
+
+typedef struct {
+  IterFrom inner;
+} IterFilter;
+typedef glue(IterFrom, _Item) glue(IterFilter, _Item);
+
+___TRAIT_UNUSED static inline IterFilter glue(IterFilter, _new)(IterFrom inner) {
+  IterFilter it = { inner };
+  return it;
+}
+
+#define For IterFilter
+#define Impl Iterator
+  static inline int def(next, glue(IterFilter, _Item) *out) {
+    while (call(Iterator.next, &self->inner, out))
+      if (IterFn(out))
+        return 1;
+    return 0;
+  }
+#include "../trait.h"
+
+#undef IterFilter
+#undef IterFrom
+#undef IterFn
+#endif // IterFilter
+
+// ── Reinclude: IterTake — at most n items ────────────────────────────────────
+#ifdef IterTake
+
+typedef struct {
+  IterFrom inner;
+  size_t left;
+} IterTake;
+typedef glue(IterFrom, _Item) glue(IterTake, _Item);
+
+___TRAIT_UNUSED static inline IterTake glue(IterTake, _new)(IterFrom inner, size_t n) {
+  IterTake it = { inner, n };
+  return it;
+}
+
+#define For IterTake
+#define Impl Iterator
+  static inline int def(next, glue(IterTake, _Item) *out) {
+    if (!self->left || !call(Iterator.next, &self->inner, out))
+      return 0;
+    self->left--;
+    return 1;
+  }
+#include "../trait.h"
+
+#undef IterTake
+#undef IterFrom
+#endif // IterTake
+
+// ── Reinclude: IterZip — pairs {a, b} until either side ends ─────────────────
+#ifdef IterZip
+
+typedef struct {
+  IterFrom a;
+  IterWith b;
+} IterZip;
+typedef struct {
+  glue(IterFrom, _Item) a;
+  glue(IterWith, _Item) b;
+} glue(IterZip, _Item);
+
+___TRAIT_UNUSED static inline IterZip glue(IterZip, _new)(IterFrom a, IterWith b) {
+  IterZip it = { a, b };
+  return it;
+}
+
+#define For IterZip
+#define Impl Iterator
+  static inline int def(next, glue(IterZip, _Item) *out) {
+    return call(Iterator.next, &self->a, &out->a) && call(Iterator.next, &self->b, &out->b);
+  }
+#include "../trait.h"
+
+#undef IterZip
+#undef IterFrom
+#undef IterWith
+#endif // IterZip
+
+// ── Reinclude: IterChain — all of From, then all of With ─────────────────────
+#ifdef IterChain
+
+typedef struct {
+  IterFrom first;
+  IterWith second;
+  int in_second;
+} IterChain;
+typedef glue(IterFrom, _Item) glue(IterChain, _Item);
+
+___TRAIT_UNUSED static inline IterChain glue(IterChain, _new)(IterFrom first, IterWith second) {
+  IterChain it = { first, second, 0 };
+  return it;
+}
+
+#define For IterChain
+#define Impl Iterator
+  static inline int def(next, glue(IterChain, _Item) *out) {
+    if (!self->in_second) {
+      if (call(Iterator.next, &self->first, out))
+        return 1;
+      self->in_second = 1;
+    }
+    return call(Iterator.next, &self->second, out);
+  }
+#include "../trait.h"
+
+#undef IterChain
+#undef IterFrom
+#undef IterWith
+#endif // IterChain
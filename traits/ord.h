@@ -0,0 +1,241 @@
+// clang-format off
+// =============================================================================
+// traits/ord.h — static Ord trait and monomorphized sort / search over it
+//
+//   #include "traits/ord.h"
+//
+//   #define For Point
+//   #define Impl Ord
+//     int constdef(cmp, const Point *other) { return (self->x > other->x) - (self->x < other->x); }
+//   #include "trait.h"
+//
+//   #define Ordered Point            // instantiate the algorithms for Point
+//   #include "traits/ord.h"
+//
+//   trait_sort(Point, pts, n);                        // introsort
+//   const Point *hit = trait_bsearch(Point, pts, n, &key);
+//   size_t i = trait_lower_bound(Point, pts, n, &key);
+//   trait_nth_element(Point, pts, n, k);              // quickselect
+//   trait_merge(Point, a, na, b, nb, out);            // stable
+//   trait_is_sorted(Point, pts, n);
+//
+// cmp returns <0, 0 or >0 like a qsort comparator.  Every comparison is
+// call(Ord.cmp, ...), resolved at compile time to Point's cmp, so it inlines
+// where qsort pays an indirect call per comparison.  Each `#define Ordered T`
+// + include emits T_sort, T_bsearch, ... as static inline functions (unused
+// ones cost nothing); instantiate once per type per TU.
+//
+// Ord is declared with OrdStatic, so including this header does not change
+// how impls of your own traits are treated (see "Static trait detection" in
+// trait.h).  Impls for int, long and double are provided.
+// =============================================================================
+#ifndef TRAIT_ORD_H
+#define TRAIT_ORD_H
+
+#include "../trait.h"
+#include <stddef.h>
+
+#define OrdSignature(Self)                       \
+  required(immutable(Self), int, cmp, const For *)
+#define OrdStatic 1
+#define Trait Ord
+#include "../trait.h"
+
+#define For int
+#define Impl Ord
+  static inline int constdef(cmp, const int *other) { return (*self > *other) - (*self < *other); }
+#include "../trait.h"
+
+#define For long
+#define Impl Ord
+  static inline int constdef(cmp, const long *other) { return (*self > *other) - (*self < *other); }
+#include "../trait.h"
+
+#define For double
+#define Impl Ord
+  static inline int constdef(cmp, const double *other) { return (*self > *other) - (*self < *other); }
+#include "../trait.h"
+
+#define trait_sort(T, a, n) glue(T, _sort)(a, n)
+#define trait_bsearch(T, a, n, key) glue(T, _bsearch)(a, n, key)
+#define trait_lower_bound(T, a, n, key) glue(T, _lower_bound)(a, n, key)
+#define trait_nth_element(T, a, n, k) glue(T, _nth_element)(a, n, k)
+#define trait_merge(T, a, na, b, nb, out) glue(T, _merge)(a, na, b, nb, out)
+#define trait_is_sorted(T, a, n) glue(T, _is_sorted)(a, n)
+
+// Below this many elements the sorts finish with insertion sort.
+#ifndef TRAIT_ORD_SMALL
+#define TRAIT_ORD_SMALL 16
+#endif
+
+#define ___TRAIT_ORD_LESS(x, y) (call(Ord.cmp, (x), (y)) < 0)
+
+#endif // TRAIT_ORD_H
+
+// ── Reinclude: instantiate the algorithms for one type ───────────────────────
+#ifdef Ordered
+
+___TRAIT_UNUSED static inline void glue(Ordered, _ord_swap)(Ordered *x, Ordered *y) {
+  Ordered t = *x;
+  *x = *y;
+  *y = t;
+}
+
+___TRAIT_UNUSED static inline void glue(Ordered, _ord_insertion)(Ordered *a, size_t n) {
+  for (size_t i = 1; i < n; i++) {
+    Ordered v = a[i];
+    size_t j = i;
+    for (; j > 0 && ___TRAIT_ORD_LESS(&v, &a[j - 1]); j--)
+      a[j] = a[j - 1];
+    a[j] = v;
+  }
+}
+
+___TRAIT_UNUSED static inline void glue(Ordered, _ord_sift)(Ordered *a, size_t i, size_t n) {
+  for (size_t c; (c = 2 * i + 1) < n; i = c) {
+    if (c + 1 < n && ___TRAIT_ORD_LESS(&a[c], &a[c + 1]))
+      c++;
+    if (!___TRAIT_ORD_LESS(&a[i], &a[c]))
+      return;
+    glue(Ordered, _ord_swap)(&a[i], &a[c]);
+  }
+}
+
+___TRAIT_UNUSED static inline void glue(Ordered, _ord_heapsort)(Ordered *a, size_t n) {
+  for (size_t i = n / 2; i-- > 0;)
+    glue(Ordered, _ord_sift)(a, i, n);
+  for (size_t end = n; end-- > 1;) {
+    glue(Ordered, _ord_swap)(&a[0], &a[end]);
+    glue(Ordered, _ord_sift)(a, 0, end);
+  }
+}
+
+// Hoare partition around the median of a[0], a[n/2], a[n-1] (n > 2).
+// Returns m < n - 1 with a[0..m] <= pivot <= a[m+1..n).
+___TRAIT_UNUSED static inline size_t glue(Ordered, _ord_partition)(Ordered *a, size_t n) {
+  size_t mid = n / 2, i = 0, j = n - 1;
+  if (___TRAIT_ORD_LESS(&a[mid], &a[0]))
+    glue(Ordered, _ord_swap)(&a[mid], &a[0]);
+  if (___TRAIT_ORD_LESS(&a[j], &a[mid])) {
+    glue(Ordered, _ord_swap)(&a[j], &a[mid]);
+    if (___TRAIT_ORD_LESS(&a[mid], &a[0]))
+      glue(Ordered, _ord_swap)(&a[mid], &a[0]);
+  }
+  Ordered p = a[mid];
+  for (;;) {
+    while (___TRAIT_ORD_LESS(&a[i], &p))
+      i++;
+    while (___TRAIT_ORD_LESS(&p, &a[j]))
+      j--;
+    if (i >= j)
+      return j;
+    glue(Ordered, _ord_swap)(&a[i], &a[j]);
+    i++;
+    j--;
+  }
+}
+
+___TRAIT_UNUSED static inline unsigned glue(Ordered, _ord_depth)(size_t n) {
+  unsigned d = 0;
+  for (; n > 1; n >>= 1)
+    d += 2;
+  return d;
+}
+
+// Introsort: quicksort, heapsort once the depth budget (2 log2 n) runs out,
+// insertion sort for short ranges.  Not stable.
+___TRAIT_UNUSED static inline void glue(Ordered, _sort)(Ordered *a, size_t n) {
+  unsigned depth = glue(Ordered, _ord_depth)(n);
+  while (n > TRAIT_ORD_SMALL) {
+    if (depth-- == 0) {
+      glue(Ordered, _ord_heapsort)(a, n);
+      return;
+    }
+    size_t m = glue(Ordered, _ord_partition)(a, n) + 1;
+    if (m < n - m) { // recurse into the smaller half, loop on the larger
+      glue(Ordered, _sort)(a, m);
+      a += m;
+      n -= m;
+    } else {
+      glue(Ordered, _sort)(a + m, n - m);
+      n = m;
+    }
+  }
+  glue(Ordered, _ord_insertion)(a, n);
+}
+
+// Index of the first element not less than *key (n if none).
+___TRAIT_UNUSED static inline size_t glue(Ordered, _lower_bound)(const Ordered *a, size_t n,
+                                                                 const Ordered *key) {
+  size_t lo = 0;
+  while (n > 0) {
+    size_t half = n / 2;
+    if (___TRAIT_ORD_LESS(&a[lo + half], key)) {
+      lo += half + 1;
+      n -= half + 1;
+    } else {
+      n = half;
+    }
+  }
+  return lo;
+}
+
+// An element equal to *key in sorted a, or NULL.
+___TRAIT_UNUSED static inline const Ordered *glue(Ordered, _bsearch)(const Ordered *a, size_t n,
+                                                                     const Ordered *key) {
+  size_t i = glue(Ordered, _lower_bound)(a, n, key);
+  return i < n && call(Ord.cmp, &a[i], key) == 0 ? &a[i] : NULL;
+}
+
+// Reorders a so that a[k] is the element a sorted array would hold there,
+// with nothing greater before it and nothing less after it.
+___TRAIT_UNUSED static inline void glue(Ordered, _nth_element)(Ordered *a, size_t n, size_t k) {
+  unsigned depth = glue(Ordered, _ord_depth)(n);
+  if (k >= n)
+    return;
+  while (n > TRAIT_ORD_SMALL) {
+    if (depth-- == 0) {
+      glue(Ordered, _ord_heapsort)(a, n);
+      return;
+    }
+    size_t m = glue(Ordered, _ord_partition)(a, n) + 1;
+    if (k < m) {
+      n = m;
+    } else {
+      a += m;
+      n -= m;
+      k -= m;
+    }
+  }
+  glue(Ordered, _ord_insertion)(a, n);
+}
+
+// Merges sorted a and b into out (na + nb elements, not overlapping either).
+// Stable: equal elements keep a's before b's.
+___TRAIT_UNUSED static inline void glue(Ordered, _merge)(const Ordered *a, size_t na,
+                                                         const Ordered *b, size_t nb,
+                                                         Ordered *out) {
+  while (na && nb) {
+    if (___TRAIT_ORD_LESS(b, a)) {
+      *out++ = *b++;
+      nb--;
+    } else {
+      *out++ = *a++;
+      na--;
+    }
+  }
+  while (na--)
+    *out++ = *a++;
+  while (nb--)
+    *out++ = *b++;
+}
+
+___TRAIT_UNUSED static inline int glue(Ordered, _is_sorted)(const Ordered *a, size_t n) {
+  for (size_t i = 1; i < n; i++)
+    if (___TRAIT_ORD_LESS(&a[i], &a[i - 1]))
+      return 0;
+  return 1;
+}
+
+#undef Ordered
+#endif // Ordered